@@ -0,0 +1,6 @@
+#pragma once
+#define PROG_LED_PIN 1
+#define PROG_LED_PIN_ACTIVE_ON HIGH
+#define PROG_BUTTON_PIN 2
+#define INFO1_LED_PIN 3
+#define INFO1_LED_PIN_ACTIVE_ON HIGH
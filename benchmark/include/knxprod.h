@@ -0,0 +1,7 @@
+#pragma once
+#define MAIN_OpenKnxId 0xA0
+#define MAIN_ApplicationNumber 1
+#define MAIN_ApplicationVersion 1
+#define MAIN_OrderNumber "BENCH"
+#define MAIN_Version "0.0.1"
+#define ParamBASE_Watchdog 0
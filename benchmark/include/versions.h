@@ -0,0 +1,2 @@
+#pragma once
+#define MODULE_Common_Version "benchmark"
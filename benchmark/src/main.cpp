@@ -0,0 +1,343 @@
+/*
+ * Host benchmark of the OGM-Common hot paths (native build).
+ *
+ * Every benchmark runs a warmup, then the given number of iterations and reports the average time per
+ * operation. The results are written as JSON or CSV, so results of different OGM-Common releases can be
+ * compared by a script. The log output of the library is written to stdout and should be discarded, so
+ * the logger benchmarks are not limited by the terminal:
+ *
+ *   .pio/build/native/program -o result.json > /dev/null
+ *
+ * Options:
+ *   -o <file>      result file (default: benchmark.json)
+ *   -f json|csv    result format (default: json)
+ *   -m <count>     number of modules for the loop benchmark (default: 8)
+ *   -s <factor>    scale the number of iterations (default: 1.0)
+ *   -b <name>      run only benchmarks starting with name (e.g. "flash")
+ *   -l <label>     label stored in the result, e.g. the OGM-Common release (default: MODULE_Common_Version)
+ */
+#include "OpenKNX.h"
+#include "OpenKNX/Native/Clock.h"
+#include "OpenKNX/Stat/DurationStatistic.h"
+#include <chrono>
+#include <functional>
+#include <vector>
+
+// the knx stack provides no global instance on Linux
+KnxFacade<LinuxPlatform, Bau57B0> knx;
+
+class BenchmarkModule : public OpenKNX::Module
+{
+  public:
+    uint16_t dataSize = 0;
+    uint32_t loops = 0;
+    uint32_t checksum = 0;
+    // write the state table in one call instead of byte by byte
+    bool typed = false;
+    uint8_t table[4096];
+    bool lazy = false;
+
+    BenchmarkModule()
+    {
+        for (uint16_t i = 0; i < sizeof(table); i++)
+            table[i] = i & 0xFF;
+    }
+
+    const std::string name() override
+    {
+        return "Benchmark";
+    }
+
+    const std::string version() override
+    {
+        return "0.0.1";
+    }
+
+    uint16_t flashSize() override
+    {
+        return dataSize;
+    }
+
+    void writeFlash() override
+    {
+        if (typed)
+        {
+            openknx.flash.writeArray(table, dataSize);
+            return;
+        }
+
+        for (uint16_t i = 0; i < dataSize; i++)
+            openknx.flash.writeByte(i & 0xFF);
+    }
+
+    bool restoreLazy() override
+    {
+        return lazy;
+    }
+
+    void readFlash(const uint8_t *data, const uint16_t size) override
+    {
+        for (uint16_t i = 0; i < size; i++)
+            checksum += data[i];
+    }
+
+    void loop(bool configured) override
+    {
+        loops++;
+    }
+};
+
+struct Result
+{
+    std::string name;
+    uint32_t iterations;
+    double totalUs;
+    double nsPerOp;
+};
+
+static BenchmarkModule modules[OPENKNX_MAX_MODULES];
+static std::vector<Result> results;
+static std::string filter;
+static double scale = 1.0;
+static std::string label = MODULE_Common_Version;
+static volatile uint32_t checksumResult = 0;
+
+static void benchmark(const std::string name, uint32_t iterations, const std::function<void()> &operation)
+{
+    if (name.compare(0, filter.size(), filter) != 0)
+        return;
+
+    iterations = MAX(1, (uint32_t)(iterations * scale));
+    for (uint32_t i = 0; i < MAX(1, iterations / 10); i++)
+        operation();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++)
+        operation();
+    const double totalUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    results.push_back({name, iterations, totalUs, totalUs * 1000.0 / iterations});
+    fprintf(stderr, "%-32s %10u %14.1f ns/op\n", name.c_str(), iterations, totalUs * 1000.0 / iterations);
+}
+
+static void benchmarkLoop()
+{
+    benchmark("loop", 200000, []() { openknx.loop(); });
+}
+
+static void benchmarkFlash(uint8_t moduleCount)
+{
+    // sizes per module, limited by the size of one slot
+    const uint16_t slotData = OPENKNX_FLASH_SIZE / OPENKNX_FLASH_SLOTS - 64;
+    for (uint16_t size : {16, 128, 512, 1024, 4096})
+    {
+        if ((uint32_t)(size + 8) * moduleCount > slotData)
+            break;
+
+        for (uint8_t i = 0; i < moduleCount; i++)
+            modules[i].dataSize = size;
+
+        const std::string variant = std::to_string(moduleCount) + "x" + std::to_string(size);
+        benchmark("flash.save." + variant, 200, []() { openknx.flash.save(true); });
+        for (uint8_t i = 0; i < moduleCount; i++)
+            modules[i].typed = true;
+        benchmark("flash.save.typed." + variant, 200, []() { openknx.flash.save(true); });
+        for (uint8_t i = 0; i < moduleCount; i++)
+            modules[i].typed = false;
+        benchmark("flash.load." + variant, 2000, []() { openknx.flash.load(); });
+
+        // boot: only the index is built, the modules are restored later
+        for (uint8_t i = 0; i < moduleCount; i++)
+            modules[i].lazy = true;
+        benchmark("flash.load.lazy." + variant, 2000, []() { openknx.flash.load(); });
+        for (uint8_t i = 0; i < moduleCount; i++)
+            modules[i].lazy = false;
+        openknx.flash.load();
+    }
+}
+
+// byte-wise reference of the flash driver checks
+static bool erasedBytewise(const uint8_t *data, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+        if (data[i] != 0xFF)
+            return false;
+
+    return true;
+}
+
+static bool needEraseBytewise(const uint8_t *flash, const uint8_t *data, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+        if (data[i] & ~flash[i])
+            return true;
+
+    return false;
+}
+
+static void benchmarkDriver()
+{
+    // worst case: the complete sector is checked
+    static uint32_t erased[1024];
+    static uint32_t data[1024];
+    static uint32_t programmed[1024];
+    memset(erased, 0xFF, sizeof(erased));
+    for (uint16_t i = 0; i < 1024; i++)
+        data[i] = i * 2654435761u;
+    memcpy(programmed, data, sizeof(data));
+
+    const uint8_t *flash = (const uint8_t *)erased;
+    const uint8_t *buffer = (const uint8_t *)data;
+    const uint8_t *current = (const uint8_t *)programmed;
+    benchmark("flash.erased.bytewise.4096", 100000, [flash]() { checksumResult = erasedBytewise(flash, 4096); });
+    benchmark("flash.erased.4096", 100000, [flash]() { checksumResult = OpenKNX::Flash::Driver::erased(flash, 4096); });
+    benchmark("flash.neederase.bytewise.4096", 100000, [current, buffer]() { checksumResult = needEraseBytewise(current, buffer, 4096); });
+    benchmark("flash.neederase.4096", 100000, [current, buffer]() { checksumResult = OpenKNX::Flash::Driver::needErase(current, buffer, 4096); });
+}
+
+static void benchmarkChecksum()
+{
+    static uint8_t data[16384];
+    for (uint16_t i = 0; i < sizeof(data); i++)
+        data[i] = i * 7;
+
+    for (uint16_t size : {1024, 4096, 16384})
+    {
+        benchmark("checksum.v1." + std::to_string(size), 20000, [size]() { checksumResult = OpenKNX::Flash::Default::calcChecksum(1, data, size); });
+        benchmark("checksum.v2." + std::to_string(size), 20000, [size]() { checksumResult = OpenKNX::Flash::Default::calcChecksum(2, data, size); });
+    }
+}
+
+static void benchmarkLogger()
+{
+    const uint8_t data[16] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+    const std::string prefix = openknx.logger.buildPrefix("Bench", 1);
+
+    openknx.logger.level(OPENKNX_LOG_LEVEL_TRACE);
+    benchmark("logger.plain", 50000, []() { logInfo("Bench", "Benchmark message"); });
+    benchmark("logger.format", 50000, []() { logInfo("Bench", "Benchmark %i %s %02X", 12345, "message", 0xAB); });
+    benchmark("logger.prefix", 50000, [&prefix]() { logInfo(prefix, "Benchmark %i", 12345); });
+    benchmark("logger.hex", 50000, [&data]() { logHexInfo("Bench", data, sizeof(data)); });
+    benchmark("logger.error", 50000, []() { logError("Bench", "Benchmark message"); });
+    benchmark("logger.debug", 50000, []() { logDebug("Bench", "Benchmark %i", 12345); });
+    benchmark("logger.trace", 50000, []() { logTrace("Bench", "Benchmark %i", 12345); });
+
+    // rejected by level (cost of a disabled log call in the firmware)
+    openknx.logger.level(OPENKNX_LOG_LEVEL_ERROR);
+    benchmark("logger.disabled", 5000000, []() { logInfo("Bench", "Benchmark %i", 12345); });
+    openknx.logger.level(OPENKNX_LOG_LEVEL);
+
+#ifdef OPENKNX_LOGGER_ASYNC
+    openknx.logger.flush();
+#endif
+}
+
+static void benchmarkStatistic()
+{
+    static OpenKNX::Stat::DurationStatistic statistic;
+    static uint32_t value = 0;
+    benchmark("stat.measure", 5000000, []() {
+        // spread the values over all buckets
+        value = value * 1103515245 + 12345;
+        statistic.measure(value >> 18);
+    });
+}
+
+static void benchmarkConsole()
+{
+    openknx.logger.level(OPENKNX_LOG_LEVEL_NONE);
+    benchmark("console.unknown", 200000, []() { openknx.console.processCommand("benchmark"); });
+    openknx.logger.level(OPENKNX_LOG_LEVEL);
+    benchmark("console.uptime", 50000, []() { openknx.console.processCommand("uptime"); });
+}
+
+static void benchmarkLed()
+{
+    static OpenKNX::Led::GPIO led;
+    led.init(99);
+    benchmark("led.off", 5000000, []() { led.loop(); });
+    led.on();
+    benchmark("led.on", 5000000, []() { led.loop(); });
+    led.blinking();
+    benchmark("led.blinking", 5000000, []() { led.loop(); });
+    led.pulsing();
+    benchmark("led.pulsing", 5000000, []() { led.loop(); });
+    led.off();
+}
+
+static bool writeResults(const char *file, const std::string &format, uint8_t moduleCount)
+{
+    FILE *output = fopen(file, "w");
+    if (output == nullptr)
+        return false;
+
+    if (format == "csv")
+    {
+        fprintf(output, "name,iterations,total_us,ns_per_op\n");
+        for (const Result &result : results)
+            fprintf(output, "%s,%u,%.1f,%.2f\n", result.name.c_str(), result.iterations, result.totalUs, result.nsPerOp);
+    }
+    else
+    {
+        fprintf(output, "{\n  \"label\": \"%s\",\n  \"modules\": %u,\n  \"results\": [\n", label.c_str(), moduleCount);
+        for (size_t i = 0; i < results.size(); i++)
+            fprintf(output, "    {\"name\": \"%s\", \"iterations\": %u, \"total_us\": %.1f, \"ns_per_op\": %.2f}%s\n",
+                    results[i].name.c_str(), results[i].iterations, results[i].totalUs, results[i].nsPerOp, i + 1 < results.size() ? "," : "");
+        fprintf(output, "  ]\n}\n");
+    }
+
+    fclose(output);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *file = "benchmark.json";
+    std::string format = "json";
+    uint8_t moduleCount = 8;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string option = argv[i];
+        if (option == "-o")
+            file = argv[i + 1];
+        else if (option == "-f")
+            format = argv[i + 1];
+        else if (option == "-m")
+            moduleCount = MIN(atoi(argv[i + 1]), OPENKNX_MAX_MODULES);
+        else if (option == "-s")
+            scale = atof(argv[i + 1]);
+        else if (option == "-b")
+            filter = argv[i + 1];
+        else if (option == "-l")
+            label = argv[i + 1];
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    for (uint8_t i = 0; i < moduleCount; i++)
+        openknx.addModule(i + 1, modules[i]);
+
+    openknx.init(0);
+    openknx.setup();
+
+    benchmarkLoop();
+    benchmarkFlash(moduleCount);
+    benchmarkDriver();
+    benchmarkChecksum();
+    benchmarkLogger();
+    benchmarkStatistic();
+    benchmarkConsole();
+    benchmarkLed();
+
+    if (!writeResults(file, format, moduleCount))
+    {
+        fprintf(stderr, "could not write %s\n", file);
+        return 1;
+    }
+
+    return 0;
+}
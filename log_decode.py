@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+#
+# Decoder for the binary log output of OGM-Common (OPENKNX_LOGGER_BINARY).
+#
+# The firmware sends the address of the format string and the raw arguments instead of formatted text.
+# This script resolves the format strings from the firmware.elf and renders the log lines like the device
+# would do. Plain text (console output, messages not encoded binary) is passed through unchanged.
+#
+# Usage:
+#   python log_decode.py .pio/build/<env>/firmware.elf                    (read from stdin)
+#   python log_decode.py .pio/build/<env>/firmware.elf -i capture.bin
+#   python log_decode.py .pio/build/<env>/firmware.elf -p /dev/ttyACM0   (requires pyserial)
+#
+# Requires pyelftools (pip install pyelftools)
+#
+import argparse
+import re
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.constants import SH_FLAGS
+
+RECORD_SEPARATOR = 0x1E
+FORMAT_SPEC = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|L|j|z|t)?([diuxXocfFeEgGaAsp%])')
+
+
+class FormatStrings:
+    def __init__(self, path):
+        self.sections = []
+        with open(path, 'rb') as file:
+            elf = ELFFile(file)
+            for section in elf.iter_sections():
+                if section['sh_flags'] & SH_FLAGS.SHF_ALLOC and section['sh_type'] == 'SHT_PROGBITS':
+                    self.sections.append((section['sh_addr'], section.data()))
+        self.cache = {}
+
+    def resolve(self, address):
+        if address not in self.cache:
+            self.cache[address] = None
+            for start, data in self.sections:
+                if start <= address < start + len(data):
+                    end = data.find(b'\0', address - start)
+                    self.cache[address] = data[address - start:end].decode('utf-8', 'replace')
+                    break
+        return self.cache[address]
+
+
+class Record:
+    def __init__(self, payload):
+        self.payload = payload
+        self.position = 0
+
+    def take(self, size):
+        data = self.payload[self.position:self.position + size]
+        if len(data) < size:
+            raise ValueError('record too short')
+        self.position += size
+        return data
+
+    def unpack(self, format):
+        return struct.unpack('<' + format, self.take(struct.calcsize('<' + format)))[0]
+
+
+def render(format, record):
+    def replace(match):
+        flags, width, precision, length, conversion = match.groups()
+        if conversion == '%':
+            return '%'
+        if width == '*':
+            width = str(record.unpack('i'))
+        if precision == '*':
+            precision = str(record.unpack('i'))
+        spec = '%' + flags + (width or '') + ('.' + precision if precision is not None else '')
+        wide = length in ('ll', 'j')
+        if conversion in 'di':
+            return (spec + 'd') % record.unpack('q' if wide else 'i')
+        if conversion in 'uxXo':
+            return (spec + conversion.replace('u', 'd')) % record.unpack('Q' if wide else 'I')
+        if conversion == 'c':
+            return (spec + 'c') % chr(record.unpack('Q' if wide else 'I') & 0xFF)
+        if conversion in 'fFeEgGaA':
+            value = record.unpack('d')
+            return (spec + (conversion if conversion not in 'aA' else 'e')) % value
+        if conversion == 's':
+            return (spec + 's') % record.take(record.unpack('B')).decode('utf-8', 'replace')
+        if conversion == 'p':
+            return (spec + 's') % ('0x%x' % record.unpack('I'))
+        return match.group(0)
+
+    return FORMAT_SPEC.sub(replace, format)
+
+
+def uptime(millis):
+    seconds = millis // 1000
+    return '%dd %02d:%02d:%02d' % (seconds // 86400 % 10000, seconds // 3600 % 24, seconds // 60 % 60, seconds % 60)
+
+
+def decode(payload, strings, prefix_length):
+    record = Record(payload)
+    address = record.unpack('I')
+    millis = record.unpack('I')
+    color = record.unpack('B')
+    indent = record.unpack('B')
+    prefix = record.take(record.unpack('B')).decode('utf-8', 'replace')
+
+    format = strings.resolve(address)
+    if format is None:
+        message = '<unknown format 0x%08x: %s>' % (address, record.payload[record.position:].hex(' '))
+    else:
+        message = render(format, record)
+
+    if prefix:
+        prefix = (prefix[:prefix_length] + ':').ljust(prefix_length + 2)
+    line = uptime(millis) + ': ' + prefix + '  ' * (indent & 0x7F) + message
+    if color:
+        line = '\x1B[%dm%s\x1B[0m' % (color, line)
+    return '\33[2K\r' + line + '\r\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode binary log output of OGM-Common')
+    parser.add_argument('elf', help='firmware.elf of the running firmware')
+    parser.add_argument('-i', '--input', help='file with captured output (default: stdin)')
+    parser.add_argument('-p', '--port', help='serial port')
+    parser.add_argument('-b', '--baud', type=int, default=115200)
+    parser.add_argument('--prefix-length', type=int, default=23, help='OPENKNX_MAX_LOG_PREFIX_LENGTH')
+    args = parser.parse_args()
+
+    strings = FormatStrings(args.elf)
+    if args.port:
+        import serial
+        source = serial.Serial(args.port, args.baud)
+    elif args.input:
+        source = open(args.input, 'rb')
+    else:
+        source = sys.stdin.buffer
+
+    output = sys.stdout.buffer
+    while True:
+        byte = source.read(1)
+        if not byte:
+            break
+        if byte[0] != RECORD_SEPARATOR:
+            output.write(byte)
+        else:
+            size = source.read(1)
+            if not size:
+                break
+            payload = source.read(size[0])
+            try:
+                output.write(decode(payload, strings, args.prefix_length).encode('utf-8'))
+            except ValueError as error:
+                output.write(('<invalid record: %s>\r\n' % error).encode('utf-8'))
+        output.flush()
+
+
+if __name__ == '__main__':
+    main()
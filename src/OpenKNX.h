@@ -4,7 +4,7 @@
 #error OGM-Common needs build-flag "-D SMALL_GROUPOBJECT"
 #endif
 
-#if !defined(ARDUINO_ARCH_SAMD) && !defined(ARDUINO_ARCH_RP2040) && !defined(ARDUINO_ARCH_ESP32)
+#if !defined(ARDUINO_ARCH_SAMD) && !defined(ARDUINO_ARCH_RP2040) && !defined(ARDUINO_ARCH_ESP32) && !defined(OPENKNX_NATIVE)
 #error Your architecture is not supported by OpenKNX
 #endif
 
@@ -38,6 +38,7 @@
 #endif
 
 #include "OpenKNX/Channel.h"
+#include "OpenKNX/ChannelIterator.h"
 #include "OpenKNX/Common.h"
 #include "OpenKNX/Facade.h"
 #include "OpenKNX/Hardware.h"
@@ -0,0 +1,108 @@
+#include "OpenKNX/ChannelIterator.h"
+#include "OpenKNX/Facade.h"
+
+namespace OpenKNX
+{
+    ChannelIterator::~ChannelIterator()
+    {
+        delete[] _cost;
+        delete[] _measured;
+#ifdef OPENKNX_RUNTIME_STAT
+        delete[] _max;
+        delete[] _calls;
+#endif
+    }
+
+    void ChannelIterator::init(uint16_t count)
+    {
+        delete[] _cost;
+        _cost = new uint16_t[count]();
+        delete[] _measured;
+        _measured = new uint8_t[(count + 7) / 8]();
+#ifdef OPENKNX_RUNTIME_STAT
+        delete[] _max;
+        delete[] _calls;
+        _max = new uint16_t[count]();
+        _calls = new uint32_t[count]();
+#endif
+        _count = count;
+        _position = 0;
+        _processed = 0;
+        _current = -1;
+    }
+
+    void ChannelIterator::measure(uint16_t index, uint32_t duration)
+    {
+        if (duration > 0xFFFF) duration = 0xFFFF;
+
+        // exponential moving average (1/8) of the runtime, seeded by the first run (as Common::processModulesLoop).
+        // A single long run raises it by OPENKNX_MAX_LOOPTIME / 8 at most.
+        const uint8_t bit = 1 << (index & 7);
+        if (_measured[index >> 3] & bit)
+        {
+            const uint32_t sample = MIN(duration, (uint32_t)_cost[index] + OPENKNX_MAX_LOOPTIME);
+            _cost[index] = _cost[index] - (_cost[index] >> 3) + (sample >> 3);
+        }
+        else
+        {
+            _cost[index] = duration;
+            _measured[index >> 3] |= bit;
+        }
+
+#ifdef OPENKNX_RUNTIME_STAT
+        _max[index] = MAX(_max[index], duration);
+        _calls[index]++;
+#endif
+    }
+
+    void ChannelIterator::finishChannel()
+    {
+        if (_current >= 0)
+        {
+            measure(_current, micros() - _begin);
+            _current = -1;
+        }
+    }
+
+    void ChannelIterator::end()
+    {
+        finishChannel();
+        _processed = 0;
+    }
+
+    bool ChannelIterator::next(uint16_t& index)
+    {
+        finishChannel();
+
+        // finish run: once completely run through, or if freeloop time over,
+        // or if the runtime of the next channel will exceed the remaining loop time
+        if (_count == 0 || _processed >= _count || (_processed > 0 && _cost[_position] >= openknx.freeLoopMicros()))
+        {
+            _processed = 0;
+            return false;
+        }
+
+        index = _position;
+        _current = _position;
+        _processed++;
+        _position++;
+        if (_position >= _count) _position = 0;
+
+        _begin = micros();
+        return true;
+    }
+
+    uint16_t ChannelIterator::cost(uint16_t index)
+    {
+        return index < _count ? _cost[index] : 0;
+    }
+
+#ifdef OPENKNX_RUNTIME_STAT
+    void ChannelIterator::showRuntimeStat(const std::string label)
+    {
+        openknx.logger.logWithPrefixAndValues(label, "channel        avg_us       max_us        calls");
+        for (uint16_t i = 0; i < _count; i++)
+            openknx.logger.logWithPrefixAndValues(label, "%7d  %12d %12d %12u", i + 1, _cost[i], _max[i], _calls[i]);
+    }
+#endif
+} // namespace OpenKNX
@@ -0,0 +1,82 @@
+#pragma once
+#include <Arduino.h>
+#include <string>
+
+namespace OpenKNX
+{
+    /*
+     * Time sliced iteration over the channels of a module.
+     *
+     * Each run processes as many channels as fit in the free loop time and resumes with the next unprocessed
+     * channel on the following run. The runtime of every channel is measured, so a channel is only started
+     * if its average runtime fits in the remaining loop time. At least one channel is processed per run and
+     * no channel is processed twice per run.
+     *
+     * Usage in Module::loop():
+     *
+     *   uint16_t i;
+     *   while (_channelIterator.next(i))
+     *       _channels[i]->loop();
+     *
+     * The runtime of a channel is measured up to the following call of next(). A caller leaving the loop
+     * early (e.g. break) has to call end() instead.
+     */
+    class ChannelIterator
+    {
+      private:
+        uint16_t _count = 0;
+        uint16_t _position = 0;
+        uint16_t _processed = 0;
+        int32_t _current = -1;
+        uint32_t _begin = 0;
+        uint16_t* _cost = nullptr;
+        // channels with at least one measured run (bit per channel)
+        uint8_t* _measured = nullptr;
+#ifdef OPENKNX_RUNTIME_STAT
+        uint16_t* _max = nullptr;
+        uint32_t* _calls = nullptr;
+#endif
+
+        void measure(uint16_t index, uint32_t duration);
+        void finishChannel();
+
+      public:
+        ChannelIterator() = default;
+        ~ChannelIterator();
+
+        // owns the runtime arrays
+        ChannelIterator(const ChannelIterator&) = delete;
+        ChannelIterator& operator=(const ChannelIterator&) = delete;
+
+        /*
+         * Set the number of channels. Must be called before the first iteration (e.g. in Module::setup()).
+         */
+        void init(uint16_t count);
+
+        /*
+         * Provide the next channel to process.
+         *
+         * @param index of the channel to process
+         * @return false if the run is finished (no free loop time left or all channels processed)
+         */
+        bool next(uint16_t& index);
+
+        /*
+         * Finish the run early: ends the measurement of the current channel.
+         * The next run resumes with the following channel.
+         */
+        void end();
+
+        /*
+         * Average runtime of a channel in µs
+         */
+        uint16_t cost(uint16_t index);
+
+#ifdef OPENKNX_RUNTIME_STAT
+        /*
+         * Print average and maximum runtime and the number of calls of each channel
+         */
+        void showRuntimeStat(const std::string label);
+#endif
+    };
+} // namespace OpenKNX
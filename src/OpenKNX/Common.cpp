@@ -2,10 +2,13 @@
 #include "OpenKNX/Facade.h"
 #include "OpenKNX/Stat/RuntimeStat.h"
 
-#if defined(OPENKNX_DUALCORE) && defined(ARDUINO_ARCH_ESP32)
+#if defined(OPENKNX_DUALCORE) && (defined(ARDUINO_ARCH_ESP32) || defined(OPENKNX_NATIVE))
 extern void loop1();
 extern void setup1();
 #endif
+#if defined(OPENKNX_DUALCORE) && defined(OPENKNX_NATIVE)
+    #include <thread>
+#endif
 
 namespace OpenKNX
 {
@@ -16,7 +19,9 @@ namespace OpenKNX
 
     void Common::init(uint8_t firmwareRevision)
     {
+#ifndef OPENKNX_NATIVE
         ArduinoPlatform::SerialDebug = new OpenKNX::Log::VirtualSerial("KNX");
+#endif
 
         openknx.timerInterrupt.init();
         openknx.hardware.initLeds();
@@ -39,7 +44,9 @@ namespace OpenKNX
     #endif
 #endif
 
+        BOOT_PROFILE_BEGIN(bootWait, "debugWait")
         debugWait();
+        BOOT_PROFILE_END(bootWait)
 
         if (openknx.watchdog.lastReset()) logErrorP("Restarted by watchdog");
 
@@ -49,13 +56,19 @@ namespace OpenKNX
         showDebugInfo();
 #endif
 
+        BOOT_PROFILE_BEGIN(bootFlash, "initFlash")
         openknx.hardware.initFlash();
+        BOOT_PROFILE_END(bootFlash)
         openknx.info.serialNumber(knx.platform().uniqueSerialNumber());
         openknx.info.firmwareRevision(firmwareRevision);
 
+        BOOT_PROFILE_BEGIN(bootKnx, "initKnx")
         initKnx();
+        BOOT_PROFILE_END(bootKnx)
 
+        BOOT_PROFILE_BEGIN(bootHardware, "initHardware")
         openknx.hardware.init();
+        BOOT_PROFILE_END(bootHardware)
     }
 
 #ifdef OPENKNX_DEBUG
@@ -135,7 +148,9 @@ namespace OpenKNX
         // set correct hardware type for flash compatibility check
         knx.bau().deviceObject().hardwareType(hardwareType);
         // read flash data
+        BOOT_PROFILE_BEGIN(bootMemory, "readMemory")
         knx.readMemory();
+        BOOT_PROFILE_END(bootMemory)
         // set hardware type again, in case an other hardware type was deserialized from flash
         knx.bau().deviceObject().hardwareType(hardwareType);
         // set firmware version as user info (PID_VERSION)
@@ -217,7 +232,11 @@ namespace OpenKNX
     {
         // Handle init of modules
         for (uint8_t i = 0; i < openknx.modules.count; i++)
+        {
+            BOOT_PROFILE_BEGIN(bootModule, "init", i)
             openknx.modules.list[i]->init();
+            BOOT_PROFILE_END(bootModule)
+        }
 
 #ifdef BASE_StartupDelayBase
         _startupDelay = millis();
@@ -232,13 +251,21 @@ namespace OpenKNX
 
         // Handle setup of modules
         for (uint8_t i = 0; i < openknx.modules.count; i++)
+        {
+            BOOT_PROFILE_BEGIN(bootModule, "setup", i)
             openknx.modules.list[i]->setup(configured);
+            BOOT_PROFILE_END(bootModule)
+        }
 
+        BOOT_PROFILE_BEGIN(bootLoad, "flash.load")
         if (configured) openknx.flash.load();
+        BOOT_PROFILE_END(bootLoad)
 
         // start the framework + isr if needed
+        BOOT_PROFILE_BEGIN(bootStart, "knx.start")
         knx.start();
         openknx.hardware.initKnxRxISR();
+        BOOT_PROFILE_END(bootStart)
 
 #ifdef OPENKNX_WATCHDOG
         if (ParamBASE_Watchdog) openknx.watchdog.activate();
@@ -259,12 +286,22 @@ namespace OpenKNX
                 ::loop1();
                 vTaskDelay(1);
             } }, "setup1AndLoop1", ARDUINO_LOOP1_STACK_SIZE, NULL, 0, nullptr, 0);
+    #elif defined(OPENKNX_NATIVE)
+        if (openknx.usesDualCore())
+            std::thread([]() -> void {
+                OpenKNX::Native::core = 1;
+                ::setup1();
+                for (;;)
+                    ::loop1();
+            }).detach();
     #endif
 
         // if we have a second core wait for setup1 is done
+        BOOT_PROFILE_BEGIN(bootSetup1, "setup1")
         if (openknx.usesDualCore())
             while (!_setup1Ready)
                 delay(1);
+        BOOT_PROFILE_END(bootSetup1)
 #endif // OPENKNX_DUALCORE
 
 #ifndef OPENKNX_DUALCORE
@@ -315,8 +352,14 @@ namespace OpenKNX
 #ifdef OPENKNX_DUALCORE
         if (!_setup1Ready) return;
 #endif
+#ifdef OPENKNX_BOOT_PROFILE
+        if (!_bootProfile.finished()) _bootProfile.finish();
+#endif
 
         RUNTIME_MEASURE_BEGIN(_runtimeLoop);
+#ifdef OPENKNX_LOOPTIME_OVERRUNS
+        _loopOverruns.begin();
+#endif
 
 #ifdef OPENKNX_HEARTBEAT
         openknx.progLed.debugLoop();
@@ -331,13 +374,25 @@ namespace OpenKNX
 
         // loop console helper
         RUNTIME_MEASURE_BEGIN(_runtimeConsole);
+        LOOP_SECTION_BEGIN(console);
         openknx.console.loop();
+        LOOP_SECTION_END(console, OPENKNX_LOOP_SECTION_CONSOLE);
         RUNTIME_MEASURE_END(_runtimeConsole);
 
+#ifdef OPENKNX_LOGGER_ASYNC
+        // write buffered log
+        openknx.logger.loop();
+#endif
+
         // loop  knx stack
-        RUNTIME_MEASURE_BEGIN(_runtimeKnxStack);
-        knx.loop();
-        RUNTIME_MEASURE_END(_runtimeKnxStack);
+        processKnxLoop();
+
+#ifdef OPENKNX_FLASH_ASYNC
+        // write one step (page or sector erase) of a pending flash commit
+        LOOP_SECTION_BEGIN(flashCommit);
+        openknx.openknxFlash.loop();
+        LOOP_SECTION_END(flashCommit, OPENKNX_LOOP_SECTION_FLASH);
+#endif
 
         // loop  appstack
         _loopMicros = micros();
@@ -350,20 +405,40 @@ namespace OpenKNX
             // Handle heartbeat delay
             processHeartbeat();
 #endif
+            LOOP_SECTION_BEGIN(flashSave);
 #ifdef BASE_PeriodicSave
             processPeriodicSave();
 #endif
 
             processSavePin();
             processRestoreSavePin();
+            LOOP_SECTION_END(flashSave, OPENKNX_LOOP_SECTION_FLASH);
             processAfterStartupDelay();
+
+            // restore lazy modules in the background
+            LOOP_SECTION_BEGIN(flashRestore);
+            if (afterStartupDelay())
+                openknx.flash.restoreNext();
+            LOOP_SECTION_END(flashRestore, OPENKNX_LOOP_SECTION_FLASH);
         }
 
         RUNTIME_MEASURE_BEGIN(_runtimeModuleLoop);
         processModulesLoop();
         RUNTIME_MEASURE_END(_runtimeModuleLoop);
 
+#ifdef OPENKNX_FLASH_SNAPSHOT
+        // refresh the save snapshot in idle time
+        LOOP_SECTION_BEGIN(flashSnapshot);
+        if (knx.configured() && !_savePinTriggered && freeLoopTime())
+            openknx.flash.loop();
+        LOOP_SECTION_END(flashSnapshot, OPENKNX_LOOP_SECTION_FLASH);
+#endif
+
         RUNTIME_MEASURE_END(_runtimeLoop);
+#ifdef OPENKNX_LOOPTIME_OVERRUNS
+        // a skipped warning (e.g. flash save) is recorded as expected
+        _loopOverruns.end(_skipLooptimeWarning);
+#endif
 
 #if OPENKNX_LOOPTIME_WARNING > 1
         // loop took to long and last out is min 1ms ago
@@ -401,6 +476,29 @@ namespace OpenKNX
         return !delayCheckMicros(_loopMicros, OPENKNX_MAX_LOOPTIME);
     }
 
+    uint32_t Common::freeLoopMicros()
+    {
+        const uint32_t used = micros() - _loopMicros;
+        return used < OPENKNX_MAX_LOOPTIME ? OPENKNX_MAX_LOOPTIME - used : 0;
+    }
+
+    bool Common::freeLoopIterate(uint16_t size, uint16_t& position, uint16_t& processed)
+    {
+        processed++;
+        position++;
+
+        // when you have to start from the beginning again
+        if (position >= size) position = 0;
+
+        // if freeloop time over
+        if (!freeLoopTime()) return false;
+
+        // once completely run through
+        if (processed >= size) return false;
+
+        return true;
+    }
+
     bool Common::freeLoopIterate(uint8_t size, uint8_t& position, uint8_t& processed)
     {
         processed++;
@@ -442,28 +540,115 @@ namespace OpenKNX
 #endif
     }
 
+    void Common::processKnxLoop()
+    {
+        RUNTIME_MEASURE_BEGIN(_runtimeKnxStack);
+        LOOP_SECTION_BEGIN(knxStack);
+        knx.loop();
+        LOOP_SECTION_END(knxStack, OPENKNX_LOOP_SECTION_KNX);
+        RUNTIME_MEASURE_END(_runtimeKnxStack);
+        _knxLoopMicros = micros();
+    }
+
+    /**
+     * Select the module to be called next: the highest priority wins, on equal priority the most overdue module.
+     * Modules already processed in this run or whose loopInterval() has not yet expired are skipped
+     * (each module is called once at start, regardless of its interval).
+     * Modules not called for OPENKNX_LOOP_STARVATION_TIME are preferred over all priorities.
+     *
+     * @return index of the module or -1 if no module is due
+     */
+    int8_t Common::nextModuleLoop(uint32_t processed)
+    {
+        const uint32_t now = micros();
+        int8_t next = -1;
+        uint16_t nextPriority = 0;
+        uint32_t nextLateness = 0;
+
+        for (uint8_t i = 0; i < openknx.modules.count; i++)
+        {
+            if (processed & (1UL << i)) continue;
+
+            const uint32_t elapsed = now - _moduleLoopMicros[i];
+            const uint32_t interval = (_moduleLoopCalled & (1UL << i)) ? openknx.modules.list[i]->loopInterval() : 0;
+            if (elapsed < interval) continue;
+
+            const uint16_t priority = elapsed >= OPENKNX_LOOP_STARVATION_TIME * 1000 ? 0x100 : openknx.modules.list[i]->loopPriority();
+            const uint32_t lateness = elapsed - interval;
+            if (next < 0 || priority > nextPriority || (priority == nextPriority && lateness > nextLateness))
+            {
+                next = i;
+                nextPriority = priority;
+                nextLateness = lateness;
+            }
+        }
+
+        return next;
+    }
+
     /**
      * Run loop() of as many modules as possible, within available free loop time.
      * Each module will be processed 0 or 1 times only, not more.
      *
-     * Repeated calls will resume with the first/next unprocessed module.
-     * For all modules the min/max number of loop()-calls will not differ more than 1.
+     * The modules are called by priority and lateness (see nextModuleLoop). A module whose predicted runtime
+     * (loopBudget() or the measured runtime) exceeds the remaining loop time is skipped for this run, unless it
+     * was not called for OPENKNX_LOOP_STARVATION_TIME. At least one module is called on each run.
+     * If processing takes longer than OPENKNX_KNX_LOOP_INTERVAL, knx.loop() is called in between.
      */
     void Common::processModulesLoop()
     {
+        static_assert(OPENKNX_MAX_MODULES <= 32, "processModulesLoop supports max 32 modules");
+
         // Skip if no modules have been added (for testing)
         if (openknx.modules.count == 0) return;
 
         bool configured = knx.configured();
 
-        uint8_t processed = 0;
-        do
+        uint32_t processed = 0;
+        bool called = false;
+        int8_t i;
+        while ((i = nextModuleLoop(processed)) >= 0)
         {
-            RUNTIME_MEASURE_BEGIN(openknx.modules.runtime[_currentModule]);
-            openknx.modules.list[_currentModule]->loop(configured);
-            RUNTIME_MEASURE_END(openknx.modules.runtime[_currentModule]);
+            processed |= (1UL << i);
+
+            const uint32_t start = micros();
+            const uint32_t used = start - _loopMicros;
+            if (called)
+            {
+                // if freeloop time over
+                if (used >= OPENKNX_MAX_LOOPTIME) break;
+
+                // predicted runtime does not fit - skip unless starving
+                const uint32_t budget = openknx.modules.list[i]->loopBudget();
+                const uint32_t predicted = budget ? budget : _moduleLoopCost[i];
+                if (predicted > OPENKNX_MAX_LOOPTIME - used && !delayCheckMicros(_moduleLoopMicros[i], OPENKNX_LOOP_STARVATION_TIME * 1000)) continue;
+            }
+
+            RUNTIME_MEASURE_BEGIN(openknx.modules.list[i]->runtime);
+            openknx.modules.list[i]->loop(configured);
+            RUNTIME_MEASURE_END(openknx.modules.list[i]->runtime);
+
+            const uint32_t duration = micros() - start;
+#ifdef OPENKNX_LOOPTIME_OVERRUNS
+            _loopOverruns.add(OPENKNX_LOOP_SECTION_MODULE + i, duration);
+#endif
+            // exponential moving average (1/8) of the runtime, seeded by the first call.
+            // A single long run raises it by OPENKNX_MAX_LOOPTIME / 8 at most, so the module is not skipped until starving.
+            if (_moduleLoopCalled & (1UL << i))
+            {
+                const uint32_t sample = MIN(duration, _moduleLoopCost[i] + OPENKNX_MAX_LOOPTIME);
+                _moduleLoopCost[i] = _moduleLoopCost[i] - (_moduleLoopCost[i] >> 3) + (sample >> 3);
+            }
+            else
+            {
+                _moduleLoopCost[i] = duration;
+                _moduleLoopCalled |= (1UL << i);
+            }
+            _moduleLoopMicros[i] = start;
+            called = true;
+
+            if (delayCheckMicros(_knxLoopMicros, OPENKNX_KNX_LOOP_INTERVAL)) processKnxLoop();
         }
-        while (freeLoopIterate(openknx.modules.count, _currentModule, processed));
     }
 
 #ifdef OPENKNX_DUALCORE
@@ -481,14 +666,16 @@ namespace OpenKNX
         #endif
     #endif
 
+        RUNTIME_MEASURE_BEGIN(_runtimeLoop1);
         bool configured = knx.configured();
 
         for (uint8_t i = 0; i < openknx.modules.count; i++)
         {
-            RUNTIME_MEASURE_BEGIN(openknx.modules.runtime1[i]);
+            RUNTIME_MEASURE_BEGIN(openknx.modules.list[i]->runtime1);
             openknx.modules.list[i]->loop1(configured);
-            RUNTIME_MEASURE_END(openknx.modules.runtime1[i]);
+            RUNTIME_MEASURE_END(openknx.modules.list[i]->runtime1);
         }
+        RUNTIME_MEASURE_END(_runtimeLoop1);
     }
 #endif
 
@@ -607,7 +794,11 @@ namespace OpenKNX
         logIndentDown();
 
         // save data
-        openknx.flash.save();
+#ifdef OPENKNX_FLASH_SNAPSHOT
+        if (!openknx.flash.saveSnapshot())
+#endif
+            openknx.flash.save();
+        openknx.flash.flush();
 
         _savedPinProcessed = millis();
         logIndentDown();
@@ -677,6 +868,7 @@ namespace OpenKNX
 
         openknx.watchdog.safeRestart();
         openknx.flash.save();
+        openknx.flash.flush();
         logIndentDown();
     }
 
@@ -690,6 +882,7 @@ namespace OpenKNX
         }
 
         openknx.flash.save();
+        openknx.flash.flush();
         logIndentDown();
     }
 
@@ -706,11 +899,59 @@ namespace OpenKNX
             return processSaveKo(ko);
     #endif
 
+        // modules without subscription receive all
+        uint32_t receivers = ~_koSubscribedModules | _koUnfilteredModules;
+
+        // find subscriptions containing asap: all candidates start before or at asap
+        const uint16_t asap = ko.asap();
+        uint16_t low = 0;
+        uint16_t high = _koSubscriptionCount;
+        while (low < high)
+        {
+            const uint16_t middle = (low + high) / 2;
+            if (_koSubscriptions[middle].first <= asap)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        for (int32_t i = low - 1; i >= 0 && _koSubscriptions[i].maxLast >= asap; i--)
+        {
+            if (_koSubscriptions[i].last >= asap)
+                receivers |= (1UL << _koSubscriptions[i].module);
+        }
+
         for (uint8_t i = 0; i < openknx.modules.count; i++)
         {
-            openknx.modules.list[i]->processInputKo(ko);
+            if (receivers & (1UL << i))
+                openknx.modules.list[i]->processInputKo(ko);
         }
     }
+
+    void Common::subscribeInputKo(Module* module, uint16_t first, uint16_t last)
+    {
+        uint8_t slot = 0;
+        while (slot < openknx.modules.count && openknx.modules.list[slot] != module) slot++;
+        if (slot >= openknx.modules.count) return;
+
+        _koSubscribedModules |= (1UL << slot);
+        if (_koSubscriptionCount >= OPENKNX_MAX_KO_SUBSCRIPTIONS)
+        {
+            // fallback: module receives all
+            logErrorP("Too many GroupObject subscriptions (increase OPENKNX_MAX_KO_SUBSCRIPTIONS)");
+            _koUnfilteredModules |= (1UL << slot);
+            return;
+        }
+
+        // insert sorted by first
+        uint16_t i = _koSubscriptionCount++;
+        for (; i > 0 && _koSubscriptions[i - 1].first > first; i--)
+            _koSubscriptions[i] = _koSubscriptions[i - 1];
+
+        _koSubscriptions[i] = {first, last, last, slot};
+
+        for (i = 0; i < _koSubscriptionCount; i++)
+            _koSubscriptions[i].maxLast = MAX(_koSubscriptions[i].last, i > 0 ? _koSubscriptions[i - 1].maxLast : 0);
+    }
 #endif
 
 #ifdef BASE_KoManualSave
@@ -799,6 +1040,11 @@ namespace OpenKNX
             if (openknx.modules.list[i]->processFunctionProperty(objectIndex, propertyId, length, data, resultData, resultLength))
                 return true;
 
+#ifdef OPENKNX_RUNTIME_STAT
+        if (objectIndex == OPENKNX_TELEMETRY_OBJECT && propertyId == OPENKNX_TELEMETRY_PROPERTY)
+            return processTelemetryFunctionProperty(length, data, resultData, resultLength);
+#endif
+
         return false;
     }
 
@@ -814,6 +1060,8 @@ namespace OpenKNX
     void Common::restart()
     {
         logInfoP("System will restart now");
+        openknx.flash.flush();
+        openknx.logger.flush();
         delay(10);
         openknx.watchdog.safeRestart();
         knx.platform().restart();
@@ -831,15 +1079,196 @@ namespace OpenKNX
             _runtimeConsole.showStat("__Console", 0, stat, hist);
             _runtimeKnxStack.showStat("__KnxStack", 0, stat, hist);
             _runtimeModuleLoop.showStat("_All_Modules_Loop", 0, stat, hist);
+    #ifdef OPENKNX_DUALCORE
+            _runtimeLoop1.showStat("___Loop", 1, stat, hist);
+    #endif
             for (uint8_t i = 0; i < openknx.modules.count; i++)
             {
-                openknx.modules.runtime[i].showStat(openknx.modules.list[i]->name().c_str(), 0, stat, hist);
+                openknx.modules.list[i]->runtime.showStat(openknx.modules.list[i]->name().c_str(), 0, stat, hist);
     #ifdef OPENKNX_DUALCORE
-                openknx.modules.runtime1[i].showStat(openknx.modules.list[i]->name().c_str(), 1, stat, hist);
+                openknx.modules.list[i]->runtime1.showStat(openknx.modules.list[i]->name().c_str(), 1, stat, hist);
     #endif
             }
         }
         logIndentDown();
+
+        if (!stat) return;
+
+        // interrupt handlers (steal their runtime from the loop of the core)
+        logInfoP("Interrupts:");
+        logIndentUp();
+        {
+            Stat::IsrStat::showStatHeader();
+            openknx.timerInterrupt.runtime.showStat("TimerInterrupt", 0);
+    #ifdef OPENKNX_DUALCORE
+            openknx.timerInterrupt.runtime1.showStat("TimerInterrupt", 1);
+    #endif
+    #if defined(ARDUINO_ARCH_RP2040) && defined(USE_TP_RX_QUEUE) && defined(USE_KNX_DMA_UART) && defined(USE_KNX_DMA_IRQ) && (MASK_VERSION == 0x07B0 || MASK_VERSION == 0x091A)
+            openknx.hardware.runtimeKnxRx.showStat("KnxRxISR", 0);
+    #endif
+            openknx.hardware.runtimeButtons.showStat("Buttons", 0);
+    #ifdef OPENKNX_SERIALLED_ENABLE
+            openknx.ledManager.runtime.showStat("SerialLedManager", 0);
+    #endif
+        }
+        logIndentDown();
+    }
+
+    void Common::resetRuntimeStat()
+    {
+        _runtimeLoop.reset();
+        _runtimeConsole.reset();
+        _runtimeKnxStack.reset();
+        _runtimeModuleLoop.reset();
+    #ifdef OPENKNX_DUALCORE
+        _runtimeLoop1.reset();
+    #endif
+        for (uint8_t i = 0; i < openknx.modules.count; i++)
+        {
+            openknx.modules.list[i]->runtime.reset();
+    #ifdef OPENKNX_DUALCORE
+            openknx.modules.list[i]->runtime1.reset();
+    #endif
+        }
+        openknx.timerInterrupt.runtime.reset();
+    #ifdef OPENKNX_DUALCORE
+        openknx.timerInterrupt.runtime1.reset();
+    #endif
+        openknx.hardware.runtimeKnxRx.reset();
+        openknx.hardware.runtimeButtons.reset();
+    #ifdef OPENKNX_SERIALLED_ENABLE
+        openknx.ledManager.runtime.reset();
+    #endif
+        logInfoP("Runtime statistics reset");
+    }
+
+    void Common::takeTelemetry()
+    {
+    #if defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_ARCH_ESP32)
+        #ifdef OPENKNX_DUALCORE
+        _telemetry.begin(freeMemoryMin(), freeStackMin(), freeStackMin1());
+        #else
+        _telemetry.begin(freeMemoryMin(), freeStackMin(), 0);
+        #endif
+    #else
+        _telemetry.begin(freeMemoryMin(), 0, 0);
+    #endif
+
+        _telemetry.add("___Loop", 0, _runtimeLoop);
+        _telemetry.add("__Console", 0, _runtimeConsole);
+        _telemetry.add("__KnxStack", 0, _runtimeKnxStack);
+        _telemetry.add("_All_Modules_Loop", 0, _runtimeModuleLoop);
+    #ifdef OPENKNX_DUALCORE
+        _telemetry.add("___Loop", 1, _runtimeLoop1);
+    #endif
+        for (uint8_t i = 0; i < openknx.modules.count; i++)
+        {
+            _telemetry.add(openknx.modules.list[i]->name(), 0, openknx.modules.list[i]->runtime);
+    #ifdef OPENKNX_DUALCORE
+            _telemetry.add(openknx.modules.list[i]->name(), 1, openknx.modules.list[i]->runtime1);
+    #endif
+        }
+
+        _telemetry.add("TimerInterrupt", 0, openknx.timerInterrupt.runtime);
+    #ifdef OPENKNX_DUALCORE
+        _telemetry.add("TimerInterrupt", 1, openknx.timerInterrupt.runtime1);
+    #endif
+    #if defined(ARDUINO_ARCH_RP2040) && defined(USE_TP_RX_QUEUE) && defined(USE_KNX_DMA_UART) && defined(USE_KNX_DMA_IRQ) && (MASK_VERSION == 0x07B0 || MASK_VERSION == 0x091A)
+        _telemetry.add("KnxRxISR", 0, openknx.hardware.runtimeKnxRx);
+    #endif
+        _telemetry.add("Buttons", 0, openknx.hardware.runtimeButtons);
+    #ifdef OPENKNX_SERIALLED_ENABLE
+        _telemetry.add("SerialLedManager", 0, openknx.ledManager.runtime);
+    #endif
+    }
+
+    /*
+     * Console: the snapshot as hex lines
+     * Diagnose KO: part n of the snapshot (7 bytes as hex), part 0 takes a new snapshot
+     */
+    void Common::exportRuntimeStat(bool diagnoseKo /* = false */, uint16_t part /* = 0 */)
+    {
+    #ifdef BASE_KoDiagnose
+        if (diagnoseKo)
+        {
+            if (part == 0)
+                takeTelemetry();
+
+            uint8_t data[7];
+            // the snapshot is limited to 64 KiB, a larger offset must not wrap around
+            const uint32_t offset = (uint32_t)part * sizeof(data);
+            const uint16_t count = offset > 0xFFFF ? 0 : _telemetry.read(offset, data, sizeof(data));
+            if (count == 0)
+            {
+                // max. 14 chars: "END 65535 TRNC"
+                openknx.console.writeDiagnoseKo(_telemetry.truncated() ? "END %u TRNC" : "END %u", _telemetry.size());
+                return;
+            }
+
+            char hex[sizeof(data) * 2 + 1] = {};
+            for (uint8_t i = 0; i < count; i++)
+                sprintf(hex + i * 2, "%02X", data[i]);
+
+            openknx.console.writeDiagnoseKo("%s", hex);
+            return;
+        }
+    #endif
+
+        takeTelemetry();
+        _telemetry.show();
+    }
+
+    /*
+     * Request: OFFSET[2] (offset 0 takes a new snapshot)
+     * Response: STATUS[1] SIZE[2] DATA (as much as fits into the response)
+     */
+    bool Common::processTelemetryFunctionProperty(uint8_t length, uint8_t* data, uint8_t* resultData, uint8_t& resultLength)
+    {
+        if (length < 2 || resultLength < 4)
+        {
+            resultData[0] = 1;
+            resultLength = 1;
+            return true;
+        }
+
+        const uint16_t offset = data[0] | (data[1] << 8);
+        if (offset == 0)
+            takeTelemetry();
+
+        const uint16_t size = _telemetry.size();
+        resultData[0] = 0;
+        resultData[1] = size & 0xFF;
+        resultData[2] = size >> 8;
+        resultLength = 3 + _telemetry.read(offset, resultData + 3, resultLength - 3);
+        return true;
+    }
+#endif
+
+#ifdef OPENKNX_BOOT_PROFILE
+    void Common::showBootProfile(bool diagnoseKo /* = false */)
+    {
+    #ifdef BASE_KoDiagnose
+        if (diagnoseKo)
+        {
+            _bootProfile.showDiagnoseKo();
+            return;
+        }
+    #endif
+        _bootProfile.show();
+    }
+#endif
+
+#ifdef OPENKNX_LOOPTIME_OVERRUNS
+    void Common::showLoopOverruns(bool diagnoseKo /* = false */)
+    {
+    #ifdef BASE_KoDiagnose
+        if (diagnoseKo)
+        {
+            _loopOverruns.showDiagnoseKo();
+            return;
+        }
+    #endif
+        _loopOverruns.show();
     }
 #endif
 
@@ -3,12 +3,16 @@
 #include "OpenKNX/Log/VirtualSerial.h"
 #ifdef OPENKNX_RUNTIME_STAT
     #include "OpenKNX/Stat/RuntimeStat.h"
+    #include "OpenKNX/Stat/Telemetry.h"
 #endif
+#include "OpenKNX/Stat/BootProfile.h"
+#include "OpenKNX/Stat/LoopOverruns.h"
 #include "OpenKNX/defines.h"
 #include "knx.h"
 
 namespace OpenKNX
 {
+    class Module;
 
     class Common
     {
@@ -17,8 +21,12 @@ namespace OpenKNX
         uint32_t _lastLooptimeWarning = 0;
         bool _skipLooptimeWarning = false;
 #endif
-        uint8_t _currentModule = 0;
         uint32_t _loopMicros = 0;
+        uint32_t _knxLoopMicros = 0;
+        uint32_t _moduleLoopMicros[OPENKNX_MAX_MODULES] = {};
+        uint32_t _moduleLoopCost[OPENKNX_MAX_MODULES] = {};
+        // modules with at least one call of loop() (bit per module)
+        uint32_t _moduleLoopCalled = 0;
         volatile bool _setup0Ready = false;
 #ifdef OPENKNX_DUALCORE
         volatile bool _setup1Ready = false;
@@ -42,7 +50,9 @@ namespace OpenKNX
 
         void initKnx();
 
+        void processKnxLoop();
         void processModulesLoop();
+        int8_t nextModuleLoop(uint32_t processed);
         void registerCallbacks();
         void processRestoreSavePin();
         void initMemoryTimerInterrupt();
@@ -72,6 +82,20 @@ namespace OpenKNX
         Stat::RuntimeStat _runtimeConsole;
         Stat::RuntimeStat _runtimeKnxStack;
         Stat::RuntimeStat _runtimeModuleLoop;
+    #ifdef OPENKNX_DUALCORE
+        Stat::RuntimeStat _runtimeLoop1;
+    #endif
+        Stat::Telemetry _telemetry;
+        void takeTelemetry();
+        bool processTelemetryFunctionProperty(uint8_t length, uint8_t* data, uint8_t* resultData, uint8_t& resultLength);
+#endif
+
+#ifdef OPENKNX_BOOT_PROFILE
+        Stat::BootProfile _bootProfile;
+#endif
+
+#ifdef OPENKNX_LOOPTIME_OVERRUNS
+        Stat::LoopOverruns _loopOverruns;
 #endif
 
 #ifdef BASE_StartupDelayBase
@@ -84,6 +108,21 @@ namespace OpenKNX
         void processSaveKo(GroupObject& ko);
 #endif
 
+#if (MASK_VERSION & 0x0900) != 0x0900 // Coupler do not have GroupObjects
+        struct KoSubscription
+        {
+            uint16_t first;
+            uint16_t last;
+            uint16_t maxLast; // max of last of this and all previous subscriptions
+            uint8_t module;
+        };
+        // sorted by first
+        KoSubscription _koSubscriptions[OPENKNX_MAX_KO_SUBSCRIPTIONS];
+        uint16_t _koSubscriptionCount = 0;
+        uint32_t _koSubscribedModules = 0;
+        uint32_t _koUnfilteredModules = 0;
+#endif
+
       public:
         /*
          * Internal public api
@@ -116,18 +155,29 @@ namespace OpenKNX
     #endif
 #endif
         bool freeLoopTime();
+        uint32_t freeLoopMicros();
         bool freeLoopIterate(uint8_t size, uint8_t& position, uint8_t& processed);
+        bool freeLoopIterate(uint16_t size, uint16_t& position, uint16_t& processed);
 
         void processSavePin();
         void processBeforeRestart();
         void processBeforeTablesUnload();
 #if (MASK_VERSION & 0x0900) != 0x0900 // Coupler do not have GroupObjects
         void processInputKo(GroupObject& ko);
+        void subscribeInputKo(Module* module, uint16_t first, uint16_t last);
 #endif
         std::string logPrefix();
 
 #ifdef OPENKNX_RUNTIME_STAT
         void showRuntimeStat(const bool stat = true, const bool hist = false);
+        void resetRuntimeStat();
+        void exportRuntimeStat(bool diagnoseKo = false, uint16_t part = 0);
+#endif
+#ifdef OPENKNX_BOOT_PROFILE
+        void showBootProfile(bool diagnoseKo = false);
+#endif
+#ifdef OPENKNX_LOOPTIME_OVERRUNS
+        void showLoopOverruns(bool diagnoseKo = false);
 #endif
     };
 } // namespace OpenKNX
@@ -133,11 +133,17 @@ namespace OpenKNX
         {
             showMemoryContent(openknx.openknxFlash.flashAddress(), openknx.openknxFlash.size());
         }
+#ifdef OPENKNX_FLASH_SNAPSHOT
+        else if (cmd == "flash snapshot")
+        {
+            openknx.flash.showSnapshot();
+        }
+#endif
         else if (cmd.substr(0, 6) == "mem 0x" && cmd.length() > 6)
         {
             std::string addrstr = cmd.substr(6, cmd.length() - 6);
             uint32_t addr = std::stoi(addrstr, nullptr, 16);
-            showMemoryContent((uint8_t*)addr, 0x40);
+            showMemoryContent((uint8_t*)(uintptr_t)addr, 0x40);
         }
 #ifndef ARDUINO_ARCH_SAMD
         else if ((!diagnoseKo && (cmd.compare(0, 3, "dw ") == 0 || cmd.compare(0, 3, "aw ") == 0)) ||
@@ -164,6 +170,45 @@ namespace OpenKNX
         {
             openknx.common.showRuntimeStat(true, true);
         }
+        else if (!diagnoseKo && (cmd == "runtime reset"))
+        {
+            openknx.common.resetRuntimeStat();
+        }
+        else if (!diagnoseKo && (cmd == "runtime export"))
+        {
+            openknx.common.exportRuntimeStat();
+        }
+        else if (diagnoseKo && cmd.compare(0, 4, "tlm ") == 0)
+        {
+            openknx.common.exportRuntimeStat(true, MIN(strtoul(cmd.substr(4).c_str(), nullptr, 10), 0xFFFFul));
+        }
+#endif
+#ifdef OPENKNX_BOOT_PROFILE
+        else if (cmd == "boot")
+        {
+            openknx.common.showBootProfile(diagnoseKo);
+        }
+#endif
+#ifdef OPENKNX_LOOPTIME_OVERRUNS
+        else if (cmd == "overruns")
+        {
+            openknx.common.showLoopOverruns(diagnoseKo);
+        }
+#endif
+        else if (!diagnoseKo && (cmd == "log level" || cmd.rfind("log level ", 0) == 0))
+        {
+            processLogLevelCommand(cmd.substr(9));
+        }
+#ifdef OPENKNX_LOG_TRACE_ENABLED
+        else if (!diagnoseKo && cmd == "trace")
+        {
+            openknx.logger.showTraceFilters();
+        }
+        else if (!diagnoseKo && cmd.length() >= 7 && cmd.rfind("trace ", 0) == 0 && cmd[6] >= '1' && cmd[6] <= '0' + OPENKNX_TRACE_FILTERS && (cmd.length() == 7 || cmd[7] == ' '))
+        {
+            openknx.logger.traceFilter(cmd[6] - '1', cmd.length() > 8 ? cmd.substr(8).c_str() : "");
+            openknx.logger.showTraceFilters();
+        }
 #endif
 #ifdef OPENKNX_WATCHDOG
         else if (cmd == "watchdog")
@@ -264,6 +309,7 @@ namespace OpenKNX
             OPENKNX_LOGGER_DEVICE.write(0x7);
             openknx.progLed.forceOn();
             openknx.flash.save(true);
+            openknx.flash.flush();
             OPENKNX_LOGGER_DEVICE.write(0x7);
             delay(10000);
             openknx.restart();
@@ -481,6 +527,9 @@ namespace OpenKNX
         printHelpLine("mem 0xXXXXXXXX", "Show memory content (64byte) starting at 0xXXXXXXXX");
         printHelpLine("flash knx", "Show knx flash content");
         printHelpLine("flash openknx", "Show openknx flash content");
+#ifdef OPENKNX_FLASH_SNAPSHOT
+        printHelpLine("flash snapshot", "Show save snapshot (size, refresh and save time)");
+#endif
 #ifdef ARDUINO_ARCH_RP2040
         printHelpLine("files, fs", "Show files on filesystem");
 #endif
@@ -488,6 +537,21 @@ namespace OpenKNX
         printHelpLine("runtime", "Show runtime statistics (Short statistic)");
         printHelpLine("runtime hist", "Show runtime histogram");
         printHelpLine("runtime full", "Show runtime statistics and histogram");
+        printHelpLine("runtime reset", "Reset runtime statistics");
+        printHelpLine("runtime export", "Export runtime statistics as hex (telemetry_decode.py)");
+#endif
+#ifdef OPENKNX_BOOT_PROFILE
+        printHelpLine("boot", "Show boot timeline (init/setup phases)");
+#endif
+#ifdef OPENKNX_LOOPTIME_OVERRUNS
+        printHelpLine("overruns", "Show the last loops exceeding OPENKNX_LOOPTIME_WARNING");
+#endif
+        printHelpLine("log level", "Show log levels (0=none 1=error 2=info 3=debug 4=trace)");
+        printHelpLine("log level <0-4>", "Set log level");
+        printHelpLine("log level <prefix> <0-4|->", "Set or remove log level of prefix");
+#ifdef OPENKNX_LOG_TRACE_ENABLED
+        printHelpLine("trace", "Show trace filters");
+        printHelpLine("trace <1-5> [regex]", "Set or clear trace filter");
 #endif
         printHelpLine("restart, r", "Restart the device");
         printHelpLine("prog, p", "Toggle the ProgMode");
@@ -526,6 +590,40 @@ namespace OpenKNX
         logEnd();
     }
 
+    void Console::processLogLevelCommand(std::string args)
+    {
+        const size_t begin = args.find_first_not_of(' ');
+        if (begin == std::string::npos)
+        {
+            openknx.logger.showLevels();
+            return;
+        }
+        args = args.substr(begin);
+
+        const size_t separator = args.rfind(' ');
+        const std::string value = separator == std::string::npos ? args : args.substr(separator + 1);
+        uint8_t level = 0xFF;
+        if (value.length() == 1 && value[0] >= '0' && value[0] <= '0' + OPENKNX_LOG_LEVEL_TRACE)
+            level = value[0] - '0';
+        else if (value != "-")
+        {
+            openknx.logger.logWithPrefix("Logger", "Invalid level");
+            return;
+        }
+
+        if (separator == std::string::npos)
+        {
+            if (level != 0xFF) openknx.logger.level(level);
+        }
+        else if (!openknx.logger.level(args.substr(0, separator).c_str(), level))
+        {
+            openknx.logger.logWithPrefix("Logger", "Too many levels by prefix (OPENKNX_LOG_LEVEL_RULES)");
+            return;
+        }
+
+        openknx.logger.showLevels();
+    }
+
     void Console::sleep()
     {
         openknx.logger.logWithValues("sleep %ims", sleepTime());
@@ -627,7 +725,7 @@ namespace OpenKNX
     void Console::showMemoryLine(uint8_t* line, uint32_t length, uint8_t* memoryStart)
     {
         char prefix[24] = {};
-        snprintf(prefix, 24, "0x%06X (0x%08X)", (uint)(line - memoryStart), (uint)line);
+        snprintf(prefix, 24, "0x%06X (0x%08X)", (uint)(line - memoryStart), (uint)(uintptr_t)line);
         openknx.logger.logHexWithPrefix(prefix, line, length);
     }
 
@@ -46,6 +46,7 @@ namespace OpenKNX
         void showFilesystemDirectory(std::string path);
 #endif
         void erase(EraseMode mode = EraseMode::All);
+        void processLogLevelCommand(std::string args);
 #ifndef ARDUINO_ARCH_SAMD
         void processPinCommand(const std::string& cmd);
 #endif
@@ -56,19 +56,33 @@ namespace OpenKNX
         return common.freeLoopTime();
     }
 
+    uint32_t Facade::freeLoopMicros()
+    {
+        return common.freeLoopMicros();
+    }
+
     bool Facade::freeLoopIterate(uint8_t size, uint8_t &position, uint8_t &processed)
     {
         return common.freeLoopIterate(size, position, processed);
     }
 
+    bool Facade::freeLoopIterate(uint16_t size, uint16_t &position, uint16_t &processed)
+    {
+        return common.freeLoopIterate(size, position, processed);
+    }
+
     void Facade::addModule(uint8_t id, Module &module)
     {
+        if (modules.count >= OPENKNX_MAX_MODULES)
+            hardware.fatalError(FATAL_MODULES, "Too many modules (increase OPENKNX_MAX_MODULES)");
+
+        if (modules.slots[id])
+            hardware.fatalError(FATAL_MODULES, "Module id already in use");
+
         modules.count++;
         modules.list[modules.count - 1] = &module;
         modules.ids[modules.count - 1] = id;
-#ifdef OPENKNX_RUNTIME_STAT
-        modules.runtime[modules.count - 1] = Stat::RuntimeStat();
-#endif
+        modules.slots[id] = modules.count;
     }
 
     Modules *Facade::getModules()
@@ -78,13 +92,8 @@ namespace OpenKNX
 
     Module *Facade::getModule(uint8_t id)
     {
-        for (uint8_t i = 0; i < modules.count; i++)
-        {
-            if (modules.ids[i] == id)
-                return modules.list[i];
-        }
-
-        return nullptr;
+        const int16_t slot = modules.slot(id);
+        return slot < 0 ? nullptr : modules.list[slot];
     }
 } // namespace OpenKNX
 OpenKNX::Facade openknx;
\ No newline at end of file
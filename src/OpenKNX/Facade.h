@@ -21,13 +21,14 @@ namespace OpenKNX
         uint8_t count = 0;
         uint8_t ids[OPENKNX_MAX_MODULES];
         Module* list[OPENKNX_MAX_MODULES];
-#ifdef OPENKNX_RUNTIME_STAT
-        // TODO check integration into Module
-        Stat::RuntimeStat runtime[OPENKNX_MAX_MODULES];
-    #ifdef OPENKNX_DUALCORE
-        Stat::RuntimeStat runtime1[OPENKNX_MAX_MODULES];
-    #endif
-#endif
+        // position in ids/list + 1 by module id (0 = not added)
+        uint8_t slots[256] = {};
+
+        /*
+         * Position of the module in ids/list
+         * @return position or -1 if no module with this id was added
+         */
+        inline int16_t slot(uint8_t id) { return (int16_t)slots[id] - 1; }
     };
 
     class Facade
@@ -89,7 +90,9 @@ namespace OpenKNX
         Modules* getModules();
         bool afterStartupDelay();
         bool freeLoopTime();
+        uint32_t freeLoopMicros();
         bool freeLoopIterate(uint8_t size, uint8_t& position, uint8_t& processed);
+        bool freeLoopIterate(uint16_t size, uint16_t& position, uint16_t& processed);
         void restart();
     };
 } // namespace OpenKNX
@@ -5,15 +5,6 @@ namespace OpenKNX
 {
     namespace Flash
     {
-        uint8_t Default::nextVersion()
-        {
-#ifdef ARDUINO_ARCH_RP2040
-            return slotVersion(_activeSlot) + 1;
-#else
-            return 0xFF;
-#endif
-        }
-
         std::string Default::logPrefix()
         {
             return "Flash<Default>";
@@ -22,34 +13,47 @@ namespace OpenKNX
         void Default::load()
         {
             const uint32_t start = millis();
-            loadedModules = new bool[openknx.modules.count];
+            memset(_loadedModules, 0, sizeof(_loadedModules));
+            memset(_pendingModules, 0, sizeof(_pendingModules));
+            _pendingCount = 0;
+#ifdef OPENKNX_FLASH_ASYNC
+            flush();
+#endif
+#ifdef OPENKNX_FLASH_DELTA
+            _deltaAppendable = false;
+#endif
             logInfoP("Load data from flash");
             logIndentUp();
-            bool found = false;
-            const bool slotValidA = validateSlot(false);
-            if (slotValidA)
-                found = true;
 
-#ifdef ARDUINO_ARCH_RP2040
-            const bool slotValidB = validateSlot(true);
-            const uint8_t slotVersionA = slotVersion(false);
-            const uint8_t slotVersionB = slotVersion(true);
-            if (slotValidB)
+            if (slotSize() == 0)
+                openknx.hardware.fatalError(FATAL_FLASH_PARAMETERS, "Flash: Slot smaller than sector");
+
+            // newest valid slot
+            bool found = false;
+            for (uint8_t slot = 0; slot < OPENKNX_FLASH_SLOTS; slot++)
             {
-                found = true;
+                if (!validateSlot(slot))
+                    continue;
 
-                if (
-                    // when slot b valid und slot a not
-                    !slotValidA ||
-                    // when slot b newer than slot a
-                    (
-                        (slotVersionB != 0xFF && slotVersionA < slotVersionB) ||
-                        (slotVersionA == 0xFF && slotVersionB == 0x0)))
+                const uint8_t format = slotFormat(slot);
+                uint32_t sequence = slotSequence(slot);
+                if (found)
                 {
-                    _activeSlot = true;
+                    // v1 only stores the lower byte of the sequence
+                    if (format == 1 && _format == 2)
+                        sequence = extendSequence(sequence, _sequence);
+                    else if (format == 2 && _format == 1)
+                        _sequence = extendSequence(_sequence, sequence);
+
+                    if (!newerSlot(format, sequence, _format, _sequence))
+                        continue;
                 }
+
+                found = true;
+                _activeSlot = slot;
+                _format = format;
+                _sequence = sequence;
             }
-#endif
 
             if (!found)
             {
@@ -58,6 +62,11 @@ namespace OpenKNX
                 return;
             }
 
+            // firmware of the active slot
+            _currentReadAddress = readOffset() - metaLength(_format);
+            _lastFirmwareNumber = readWord();
+            _lastFirmwareVersion = readWord();
+
             loadModuleData();
             initUnloadedModules();
 
@@ -68,22 +77,19 @@ namespace OpenKNX
             logIndentDown();
         }
 
-        uint16_t Default::slotOffset(bool slot)
+        /**
+         * End of the slot (the data is aligned to the end)
+         */
+        uint32_t Default::slotOffset(uint8_t slot)
         {
-#ifdef ARDUINO_ARCH_RP2040
-            return slotSize() + (slot ? slotSize() : 0);
-#else
-            return slotSize();
-#endif
+            return openknx.openknxFlash.size() - (OPENKNX_FLASH_SLOTS - 1 - slot) * slotSize();
         }
 
-        uint16_t Default::slotSize()
+        uint32_t Default::slotSize()
         {
-#ifdef ARDUINO_ARCH_RP2040
-            return openknx.openknxFlash.size() / 2;
-#else
-            return openknx.openknxFlash.size();
-#endif
+            // aligned to sectors, so a slot can be erased without touching the others
+            const uint32_t sectorSize = openknx.openknxFlash.sectorSize();
+            return openknx.openknxFlash.size() / OPENKNX_FLASH_SLOTS / sectorSize * sectorSize;
         }
 
         uint32_t Default::readOffset()
@@ -96,37 +102,31 @@ namespace OpenKNX
             return slotOffset(nextSlot());
         }
 
-        bool Default::nextSlot()
+        uint8_t Default::nextSlot()
         {
-#ifdef ARDUINO_ARCH_RP2040
-            return !_activeSlot;
-#else
-            return false;
-#endif
+            return (_activeSlot + 1) % OPENKNX_FLASH_SLOTS;
         }
 
-        bool Default::validateSlot(bool slot)
+        bool Default::validateSlot(uint8_t slot)
         {
-
-#ifndef ARDUINO_ARCH_RP2040
-            if (slot)
-                return false;
-#endif
             logDebugP("Validate slot %i", slot);
             logIndentUp();
-            logHexTraceP(openknx.openknxFlash.flashAddress() + slotOffset(slot) - FLASH_DATA_META_LEN, FLASH_DATA_META_LEN);
 
             // validate magicwords exists (at last position)
-            _currentReadAddress = slotOffset(slot) - FLASH_DATA_INIT_LEN;
-            if (FLASH_DATA_INIT != readInt())
+            const uint8_t format = slotFormat(slot);
+            if (!format)
             {
                 logDebugP("No data found");
                 logIndentDown();
                 return false;
             }
 
+            const uint8_t metaSize = metaLength(format);
+            logDebugP("Format: v%i", format);
+            logHexTraceP(openknx.openknxFlash.flashAddress() + slotOffset(slot) - metaSize, metaSize);
+
             // validate FirmwareVersion/Number
-            _currentReadAddress = slotOffset(slot) - FLASH_DATA_META_LEN;
+            _currentReadAddress = slotOffset(slot) - metaSize;
             _lastFirmwareNumber = readWord();
             logDebugP("Firmware number: 0x%04X", _lastFirmwareNumber);
             _lastFirmwareVersion = readWord();
@@ -142,23 +142,24 @@ namespace OpenKNX
 
             const uint16_t dataSize = readWord();
             logDebugP("Data size: %i", dataSize);
+            _currentReadAddress += padLength(format, FLASH_DATA_APP_LEN + FLASH_DATA_SIZE_LEN);
 
-            const uint8_t version = readByte();
-            // (version >= 0); // do nothing prevents warning for line above
-            (void)version;
+            const uint32_t sequence = format == 1 ? readByte() : readInt();
+            // (sequence >= 0); // do nothing prevents warning for line above
+            (void)sequence;
 
-            logDebugP("Version: %i", version);
+            logDebugP("Sequence: %u", sequence);
 
-            const uint16_t checksum = readWord();
-            logDebugP("Checksum: %i", checksum);
+            const uint32_t checksum = format == 1 ? readWord() : readInt();
+            logDebugP("Checksum: %u", checksum);
 
             // validate checksum
-            _currentReadAddress = slotOffset(slot) - FLASH_DATA_META_LEN - dataSize;
-            const uint16_t checksumSize = dataSize + FLASH_DATA_APP_LEN + FLASH_DATA_SIZE_LEN + FLASH_DATA_VERSION;
-            if (!verifyChecksum(currentFlash(), checksumSize, checksum))
+            _currentReadAddress = slotOffset(slot) - metaSize - dataSize;
+            const uint16_t checksumSize = dataSize + metaLength(format) - checksumLength(format) - FLASH_DATA_INIT_LEN;
+            if (!verifyChecksum(format, currentFlash(), checksumSize, checksum))
             {
                 logErrorP("Checksum invalid!");
-                logHexErrorP(openknx.openknxFlash.flashAddress() + slotOffset(slot) - FLASH_DATA_META_LEN - dataSize, checksumSize);
+                logHexErrorP(openknx.openknxFlash.flashAddress() + slotOffset(slot) - metaSize - dataSize, checksumSize);
                 logIndentDown();
                 return false;
             }
@@ -167,14 +168,94 @@ namespace OpenKNX
             return true;
         }
 
-        uint8_t Default::slotVersion(bool slot)
+        /**
+         * Sequence number of the save in the slot (v1: 8 bit version)
+         */
+        uint32_t Default::slotSequence(uint8_t slot)
         {
-#ifndef ARDUINO_ARCH_RP2040
-            if (slot)
-                return false;
-#endif
-            _currentReadAddress = slotOffset(slot) - FLASH_DATA_INIT_LEN - FLASH_DATA_CHK_LEN - FLASH_DATA_VERSION;
-            return readByte();
+            const uint8_t format = slotFormat(slot);
+            if (format == 1)
+            {
+                _currentReadAddress = slotOffset(slot) - FLASH_DATA_INIT_LEN - FLASH_DATA_CHK_LEN - FLASH_DATA_VERSION;
+                return readByte();
+            }
+
+            _currentReadAddress = slotOffset(slot) - FLASH_DATA_INIT_LEN - FLASH_DATA_CHK_V2_LEN - FLASH_DATA_SEQUENCE_LEN;
+            return readInt();
+        }
+
+        /**
+         * Compare two saves
+         * @return true if the first one is newer
+         */
+        bool Default::newerSlot(uint8_t format, uint32_t sequence, uint8_t otherFormat, uint32_t otherSequence)
+        {
+            // v1 version wraps around after 0xFF, so a v1 save is compared by the lower byte (in order of writing,
+            // regardless of the format)
+            if (format == 1 || otherFormat == 1)
+                return (int8_t)(sequence - otherSequence) > 0;
+
+            return sequence > otherSequence;
+        }
+
+        /**
+         * 32 bit sequence of a v1 save (lower byte) next to a v2 save
+         */
+        uint32_t Default::extendSequence(uint32_t version, uint32_t sequence)
+        {
+            return sequence + (int8_t)(version - sequence);
+        }
+
+        /**
+         * Format of the data in the slot by INIT
+         * @return 1 or 2, 0 if no data
+         */
+        uint8_t Default::slotFormat(uint8_t slot)
+        {
+            _currentReadAddress = slotOffset(slot) - FLASH_DATA_INIT_LEN;
+            switch (readInt())
+            {
+                case FLASH_DATA_INIT:
+                    return 1;
+                case FLASH_DATA_INIT_V2:
+                    return 2;
+                default:
+                    return 0;
+            }
+        }
+
+        uint8_t Default::checksumLength(uint8_t format)
+        {
+            return format == 1 ? FLASH_DATA_CHK_LEN : FLASH_DATA_CHK_V2_LEN;
+        }
+
+        uint8_t Default::metaLength(uint8_t format)
+        {
+            return format == 1 ? FLASH_DATA_META_LEN : FLASH_DATA_META_V2_LEN;
+        }
+
+        /**
+         * Padding after length bytes to the next aligned position (v1: none)
+         */
+        uint8_t Default::padLength(uint8_t format, uint32_t length)
+        {
+            return format == 1 ? 0 : (FLASH_DATA_ALIGN - length % FLASH_DATA_ALIGN) % FLASH_DATA_ALIGN;
+        }
+
+        /**
+         * Length of MOD_META incl. padding (offset of MOD_DATA in the block)
+         */
+        uint8_t Default::blockHeaderLength(uint8_t format)
+        {
+            return FLASH_DATA_MODULE_ID_LEN + FLASH_DATA_SIZE_LEN + padLength(format, FLASH_DATA_MODULE_ID_LEN + FLASH_DATA_SIZE_LEN);
+        }
+
+        /**
+         * Length of the complete block of a module in DATA
+         */
+        uint32_t Default::blockLength(uint8_t format, uint16_t moduleSize)
+        {
+            return blockHeaderLength(format) + moduleSize + padLength(format, moduleSize);
         }
 
         /**
@@ -189,18 +270,94 @@ namespace OpenKNX
                 const uint8_t moduleId = openknx.modules.ids[i];
                 const uint16_t moduleSize = module->flashSize();
 
-                if (moduleSize > 0 && !loadedModules[moduleId])
+                if (moduleSize > 0 && !_loadedModules[i])
                 {
+                    if (module->restoreLazy())
+                    {
+                        _pendingModules[i] = true;
+                        _pendingCount++;
+                        continue;
+                    }
+
                     logDebugP("Init unloaded module %s (%i)", module->name().c_str(), moduleId);
-                    module->readFlash(new uint8_t[0], 0);
+                    module->readFlash(nullptr, 0);
+                }
+            }
+        }
+
+        /**
+         * Call readFlash() of a lazy module with its data (or for init)
+         */
+        void Default::restoreModule(uint8_t index)
+        {
+            if (!_pendingModules[index])
+                return;
+
+            _pendingModules[index] = false;
+            _pendingCount--;
+            _loadedModules[index] = true;
+
+            Module *module = openknx.modules.list[index];
+            if (_moduleAddress[index] == 0)
+            {
+                logDebugP("Init unloaded module %s (%i)", module->name().c_str(), openknx.modules.ids[index]);
+                module->readFlash(nullptr, 0);
+                return;
+            }
+
+            _currentReadAddress = _moduleAddress[index];
+            logInfoP("Restore module %s (%i) with %i bytes (lazy)", module->name().c_str(), openknx.modules.ids[index], _moduleSize[index]);
+            logIndentUp();
+            logHexTraceP(currentFlash(), _moduleSize[index]);
+            module->readFlash(currentFlash(), _moduleSize[index]);
+            logIndentDown();
+        }
+
+        /**
+         * All lazy modules are restored before their data is saved (the data locations change with a save)
+         */
+        void Default::restoreModules()
+        {
+            for (uint8_t i = 0; _pendingCount > 0 && i < openknx.modules.count; i++)
+                restoreModule(i);
+        }
+
+        void Default::restore(Module *module)
+        {
+            for (uint8_t i = 0; _pendingCount > 0 && i < openknx.modules.count; i++)
+                if (openknx.modules.list[i] == module)
+                    restoreModule(i);
+        }
+
+        void Default::restoreNext()
+        {
+            if (_pendingCount == 0)
+                return;
+
+            for (uint8_t i = 0; i < openknx.modules.count; i++)
+            {
+                if (_pendingModules[i])
+                {
+                    restoreModule(i);
+                    return;
                 }
             }
         }
 
-        void Default::eraseSlot(bool slot)
+        void Default::eraseSlot(uint8_t slot, bool async /* = false */)
         {
 #ifdef ARDUINO_ARCH_RP2040
             // On RP2020 we need to erase next slot for fast writing on powerloss
+    #ifdef OPENKNX_FLASH_ASYNC
+            if (async)
+            {
+                logDebugP("Erase slot %i (async)", slot);
+                const uint32_t sectorSize = openknx.openknxFlash.sectorSize();
+                openknx.openknxFlash.eraseAsync((slotOffset(slot) - slotSize()) / sectorSize, slotSize() / sectorSize);
+                commit(true);
+                return;
+            }
+    #endif
     #ifdef OPENKNX_DEBUG
             const uint32_t start = millis();
     #endif
@@ -213,43 +370,233 @@ namespace OpenKNX
 #endif
         }
 
+        /**
+         * Write the buffered data to the flash
+         * @param async in steps from the loop (only with OPENKNX_FLASH_ASYNC)
+         */
+        void Default::commit(bool async)
+        {
+#ifdef OPENKNX_FLASH_ASYNC
+            if (async)
+            {
+                const uint32_t start = millis();
+                openknx.openknxFlash.commitAsync([this, start]() {
+                    logDebugP("Commit completed (%ims)", millis() - start);
+                });
+                return;
+            }
+#endif
+            openknx.openknxFlash.commit();
+        }
+
+        void Default::flush()
+        {
+            openknx.openknxFlash.commit();
+        }
+
         void Default::loadModuleData()
         {
             logInfoP("Load module data (from slot %i)", _activeSlot);
             logIndentUp();
 
             // reread data size for calc
-            _currentReadAddress = readOffset() - FLASH_DATA_INIT_LEN - FLASH_DATA_CHK_LEN - FLASH_DATA_VERSION - FLASH_DATA_SIZE_LEN;
+            _currentReadAddress = readOffset() - metaLength(_format) + FLASH_DATA_APP_LEN;
             const uint16_t dataSize = readWord();
 
-            // process data
-            _currentReadAddress = readOffset() - FLASH_DATA_META_LEN - dataSize;
+            // locate data
+            const uint32_t dataStart = readOffset() - metaLength(_format) - dataSize;
+            _currentReadAddress = dataStart;
+            memset(_moduleAddress, 0, sizeof(_moduleAddress));
 
             uint32_t dataProcessed = 0;
             while (dataProcessed < dataSize)
             {
                 uint8_t moduleId = readByte();
                 uint16_t moduleSize = readWord();
-                Module *module = openknx.getModule(moduleId);
-                dataProcessed += FLASH_DATA_MODULE_ID_LEN + FLASH_DATA_SIZE_LEN + moduleSize;
-                if (module == nullptr)
+                const int16_t slot = openknx.modules.slot(moduleId);
+                dataProcessed += blockLength(_format, moduleSize);
+                if (slot < 0)
                 {
                     logInfoP("Skip module with id %i (not found)", moduleId);
                 }
                 else
                 {
-                    logInfoP("Restore module %s (%i) with %i bytes", module->name().c_str(), moduleId, moduleSize);
-                    logIndentUp();
-                    logHexTraceP(currentFlash(), moduleSize);
-                    module->readFlash(currentFlash(), moduleSize);
-                    loadedModules[moduleId] = true;
-                    logIndentDown();
+                    _moduleAddress[slot] = _currentReadAddress + padLength(_format, FLASH_DATA_MODULE_ID_LEN + FLASH_DATA_SIZE_LEN);
+                    _moduleSize[slot] = moduleSize;
+                }
+                _currentReadAddress = dataStart + dataProcessed;
+            }
+
+#ifdef OPENKNX_FLASH_DELTA
+            loadDeltaRecords(dataStart);
+#endif
+
+            // process data
+            for (uint8_t i = 0; i < openknx.modules.count; i++)
+            {
+                if (_moduleAddress[i] == 0)
+                    continue;
+
+                Module *module = openknx.modules.list[i];
+                if (module->restoreLazy())
+                {
+                    logDebugP("Defer module %s (%i)", module->name().c_str(), openknx.modules.ids[i]);
+                    _pendingModules[i] = true;
+                    _pendingCount++;
+                    continue;
                 }
-                _currentReadAddress = readOffset() - FLASH_DATA_META_LEN - dataSize + dataProcessed;
+
+                _currentReadAddress = _moduleAddress[i];
+                logInfoP("Restore module %s (%i) with %i bytes", module->name().c_str(), openknx.modules.ids[i], _moduleSize[i]);
+                logIndentUp();
+                logHexTraceP(currentFlash(), _moduleSize[i]);
+                module->readFlash(currentFlash(), _moduleSize[i]);
+                _loadedModules[i] = true;
+                logIndentDown();
             }
             logIndentDown();
         }
 
+#ifdef OPENKNX_FLASH_DELTA
+        /**
+         * Apply the records in front of DATA (end) to the module data locations.
+         */
+        void Default::loadDeltaRecords(uint32_t end)
+        {
+            uint32_t address = readOffset() - slotSize();
+            uint16_t records = 0;
+            const uint8_t checksumSize = checksumLength(_format);
+            _deltaAppendable = false;
+            _deltaEnd = end;
+
+            while (address + FLASH_DATA_DELTA_HEAD_LEN + checksumSize <= end)
+            {
+                _currentReadAddress = address;
+                const uint8_t mark = readByte();
+                if (mark == FLASH_DATA_FILLBYTE)
+                {
+                    // new records are only appended in the current format
+                    _deltaAppendable = (_format == OPENKNX_FLASH_FORMAT);
+                    break;
+                }
+
+                if (mark != FLASH_DATA_DELTA_MARK)
+                {
+                    logErrorP("Delta record at %i invalid", address);
+                    break;
+                }
+
+                const uint8_t moduleId = readByte();
+                const uint16_t moduleSize = readWord();
+                const uint8_t padSize = padLength(_format, moduleSize);
+                if (address + FLASH_DATA_DELTA_HEAD_LEN + moduleSize + padSize + checksumSize > end)
+                {
+                    logErrorP("Delta record at %i invalid", address);
+                    break;
+                }
+
+                _currentReadAddress += moduleSize + padSize;
+                const uint32_t checksum = _format == 1 ? readWord() : readInt();
+                if (!verifyChecksum(_format, openknx.openknxFlash.flashAddress() + address + FLASH_DATA_DELTA_MARK_LEN, FLASH_DATA_MODULE_ID_LEN + FLASH_DATA_SIZE_LEN + moduleSize + padSize, checksum))
+                {
+                    logErrorP("Delta record at %i: Checksum invalid!", address);
+                    break;
+                }
+
+                const int16_t slot = openknx.modules.slot(moduleId);
+                if (slot >= 0)
+                {
+                    _moduleAddress[slot] = address + FLASH_DATA_DELTA_MARK_LEN + FLASH_DATA_MODULE_ID_LEN + FLASH_DATA_SIZE_LEN;
+                    _moduleSize[slot] = moduleSize;
+                }
+
+                address += FLASH_DATA_DELTA_HEAD_LEN + moduleSize + padSize + checksumSize;
+                records++;
+            }
+
+            _deltaAddress = address;
+            logDebugP("Delta records: %i (%i bytes free)", records, _deltaAppendable ? end - address : 0);
+        }
+
+        /**
+         * Append records for all changed modules.
+         * @return false if a full save is needed
+         */
+        bool Default::saveDelta()
+        {
+            if (!_deltaAppendable)
+                return false;
+
+            uint16_t bufferSize = 0;
+            for (uint8_t i = 0; i < openknx.modules.count; i++)
+            {
+                const uint16_t moduleSize = openknx.modules.list[i]->flashSize();
+                if (moduleSize == 0)
+                    continue;
+
+                // layout changed
+                if (_moduleAddress[i] == 0 || _moduleSize[i] != moduleSize)
+                    return false;
+
+                bufferSize = MAX(bufferSize, moduleSize);
+            }
+
+            uint8_t *buffer = new uint8_t[bufferSize];
+            uint16_t records = 0;
+            uint32_t written = 0;
+            bool success = true;
+            for (uint8_t i = 0; i < openknx.modules.count; i++)
+            {
+                Module *module = openknx.modules.list[i];
+                const uint16_t moduleSize = module->flashSize();
+                if (moduleSize == 0)
+                    continue;
+
+                // serialize into buffer
+                _writeBuffer = buffer;
+                _currentWriteAddress = 0;
+                _maxWriteAddress = moduleSize;
+                module->writeFlash();
+                writeFilldata();
+                _writeBuffer = nullptr;
+
+                if (!memcmp(buffer, openknx.openknxFlash.flashAddress() + _moduleAddress[i], moduleSize))
+                    continue;
+
+                const uint32_t recordSize = FLASH_DATA_DELTA_HEAD_LEN + moduleSize + padLength(OPENKNX_FLASH_FORMAT, moduleSize) + checksumLength(OPENKNX_FLASH_FORMAT);
+                if (_deltaAddress + recordSize > _deltaEnd)
+                {
+                    logDebugP("No space for delta record of module %s", module->name().c_str());
+                    success = false;
+                    break;
+                }
+
+                logDebugP("Save module %s (%i) with %i bytes", module->name().c_str(), openknx.modules.ids[i], moduleSize);
+                _currentWriteAddress = _deltaAddress;
+                _maxWriteAddress = _deltaAddress + recordSize;
+                writeByte(FLASH_DATA_DELTA_MARK);
+                _checksum = 0;
+                writeByte(openknx.modules.ids[i]);
+                writeWord(moduleSize);
+                write(buffer, moduleSize);
+                writePadding(moduleSize);
+                writeChecksum();
+
+                _moduleAddress[i] = _deltaAddress + FLASH_DATA_DELTA_MARK_LEN + FLASH_DATA_MODULE_ID_LEN + FLASH_DATA_SIZE_LEN;
+                _deltaAddress += recordSize;
+                written += recordSize;
+                records++;
+            }
+            delete[] buffer;
+
+            commit(true);
+            if (success)
+                logInfoP("Saved %i delta records with %i bytes (%i bytes free)", records, written, _deltaEnd - _deltaAddress);
+
+            return success;
+        }
+#endif
+
         void Default::save(bool force /* = false */)
         {
             openknx.common.skipLooptimeWarning();
@@ -268,61 +615,121 @@ namespace OpenKNX
 
             _lastWrite = millis();
 
+#ifdef OPENKNX_FLASH_ASYNC
+            // the data of the last save is compared and read from flash
+            if (openknx.openknxFlash.busy())
+                flush();
+#endif
+            restoreModules();
+
             logBegin();
             logInfoP("Save data to flash%s", force ? " (force)" : "");
             logIndentUp();
+#ifdef OPENKNX_FLASH_DELTA
+            if (saveDelta())
+            {
+                logInfoP("Save completed (%ims)", millis() - start);
+                logIndentDown();
+                logEnd();
+                return;
+            }
+            _checksum = 0;
+#endif
+            saveData(false);
+            logInfoP("Save completed (%ims)", millis() - start);
+            logIndentDown();
+            logEnd();
+        }
+
+        /**
+         * Write DATA and META to the next slot (full save), the module data is serialized or taken from the snapshot
+         */
+        void Default::saveData(bool snapshot)
+        {
+            const uint32_t start = micros();
             logDebugP("Slot %i", nextSlot());
 
             // determine some values
             uint16_t dataSize = 0;
-            for (uint8_t i = 0; i < openknx.modules.count; i++)
-            {
-                const uint16_t moduleSize = openknx.modules.list[i]->flashSize();
-                if (moduleSize == 0)
-                    continue;
+#ifdef OPENKNX_FLASH_SNAPSHOT
+            if (snapshot)
+                dataSize = _snapshotSize;
+            else
+#endif
+                for (uint8_t i = 0; i < openknx.modules.count; i++)
+                {
+                    const uint16_t moduleSize = openknx.modules.list[i]->flashSize();
+                    if (moduleSize == 0)
+                        continue;
 
-                dataSize += moduleSize +
-                            FLASH_DATA_MODULE_ID_LEN +
-                            FLASH_DATA_SIZE_LEN;
-            }
+                    dataSize += blockLength(OPENKNX_FLASH_FORMAT, moduleSize);
+                }
 
             logTraceP("dataSize: %i", dataSize);
 
             // start point
             _currentWriteAddress = writeOffset() -
                                    dataSize -
-                                   FLASH_DATA_META_LEN;
+                                   metaLength(OPENKNX_FLASH_FORMAT);
 
             logTraceP("startPosition: %i", _currentWriteAddress);
 
-            for (uint8_t i = 0; i < openknx.modules.count; i++)
-            {
-                // get data
-                Module *module = openknx.modules.list[i];
-                uint16_t moduleSize = module->flashSize();
-                uint8_t moduleId = openknx.modules.ids[i];
-
-                if (moduleSize == 0)
-                    continue;
-
-                _maxWriteAddress = _currentWriteAddress +
-                                   FLASH_DATA_MODULE_ID_LEN +
-                                   FLASH_DATA_SIZE_LEN;
-
-                // write header for module data
-                writeByte(moduleId);
-                writeWord(moduleSize);
+#if defined(OPENKNX_FLASH_DELTA) && !defined(ARDUINO_ARCH_RP2040)
+            // remove the delta records (on RP2040 the slot is already erased)
+            openknx.openknxFlash.write(writeOffset() - slotSize(), FLASH_DATA_FILLBYTE, _currentWriteAddress - (writeOffset() - slotSize()));
+#endif
+#ifdef OPENKNX_FLASH_DELTA
+            _deltaAddress = writeOffset() - slotSize();
+            _deltaEnd = _currentWriteAddress;
+            _deltaAppendable = true;
+#endif
 
-                // write the module data
-                _maxWriteAddress = _currentWriteAddress + moduleSize;
+#ifdef OPENKNX_FLASH_SNAPSHOT
+            if (snapshot)
+            {
+                for (uint8_t i = 0; i < openknx.modules.count; i++)
+                {
+                    _moduleAddress[i] = _snapshotOffset[i] ? _currentWriteAddress + _snapshotOffset[i] : 0;
+                    _moduleSize[i] = openknx.modules.list[i]->flashSize();
+                }
 
-                logDebugP("Save module %s (%i) with %i bytes", module->name().c_str(), moduleId, moduleSize);
-                module->writeFlash();
-                writeFilldata();
+                _maxWriteAddress = _currentWriteAddress + dataSize;
+                write(_snapshot, dataSize);
             }
+            else
+#endif
+                for (uint8_t i = 0; i < openknx.modules.count; i++)
+                {
+                    // get data
+                    Module *module = openknx.modules.list[i];
+                    uint16_t moduleSize = module->flashSize();
+                    uint8_t moduleId = openknx.modules.ids[i];
+
+                    if (moduleSize == 0)
+                        continue;
+
+                    _maxWriteAddress = _currentWriteAddress +
+                                       FLASH_DATA_MODULE_ID_LEN +
+                                       FLASH_DATA_SIZE_LEN;
+
+                    // write header for module data
+                    writeByte(moduleId);
+                    writeWord(moduleSize);
+                    writePadding(FLASH_DATA_MODULE_ID_LEN + FLASH_DATA_SIZE_LEN);
+
+                    // write the module data
+                    _maxWriteAddress = _currentWriteAddress + moduleSize;
+                    _moduleAddress[i] = _currentWriteAddress;
+                    _moduleSize[i] = moduleSize;
+
+                    logDebugP("Save module %s (%i) with %i bytes", module->name().c_str(), moduleId, moduleSize);
+                    module->writeFlash();
+                    writeFilldata();
+                    writePadding(moduleSize);
+                }
 
             // write magicword
-            _maxWriteAddress = _currentWriteAddress + FLASH_DATA_META_LEN;
+            _maxWriteAddress = _currentWriteAddress + metaLength(OPENKNX_FLASH_FORMAT);
 
             // application info
             writeWord(openknx.info.firmwareNumber());
@@ -330,53 +737,232 @@ namespace OpenKNX
 
             // write size
             writeWord(dataSize);
+            writePadding(FLASH_DATA_APP_LEN + FLASH_DATA_SIZE_LEN);
 
-            // write version
-            logDebugP("Version %i", nextVersion());
-            writeByte(nextVersion());
+            // write sequence
+            if (OPENKNX_FLASH_FORMAT == 1)
+                writeByte(_sequence + 1);
+            else
+                writeInt(_sequence + 1);
 
             // write checksum
-            writeWord(_checksum);
+            writeChecksum();
 
             // block of metadata
-            writeInt(FLASH_DATA_INIT);
+            writeInt(OPENKNX_FLASH_FORMAT == 1 ? FLASH_DATA_INIT : FLASH_DATA_INIT_V2);
+            _format = OPENKNX_FLASH_FORMAT;
 
-            openknx.openknxFlash.commit();
-            logHexTraceP(openknx.openknxFlash.flashAddress() + writeOffset() - dataSize - FLASH_DATA_META_LEN, dataSize + FLASH_DATA_META_LEN);
+            // power loss (snapshot): write now
+            commit(!snapshot);
+            _saveDuration = micros() - start;
 
-            logInfoP("Save completed (%ims)", millis() - start);
+            logDebugP("Sequence %u", _sequence + 1);
+            logHexTraceP(openknx.openknxFlash.flashAddress() + writeOffset() - dataSize - metaLength(_format), dataSize + metaLength(_format));
 
-#ifdef ARDUINO_ARCH_RP2040
             // new active slot
-            _activeSlot = !_activeSlot;
+            _activeSlot = nextSlot();
+            _sequence++;
 
+#ifdef ARDUINO_ARCH_RP2040
             // erase next slot
-            eraseSlot(nextSlot());
+            eraseSlot(nextSlot(), !snapshot);
 #endif
+        }
+
+#ifdef OPENKNX_FLASH_SNAPSHOT
+        bool Default::saveSnapshot()
+        {
+            if (_snapshot == nullptr || _snapshotPending)
+                return false;
+
+            openknx.common.skipLooptimeWarning();
+            _checksum = 0;
+
+            if (!knx.configured())
+                return true;
+
+            if (_lastWrite > 0 && !delayCheck(_lastWrite, FLASH_DATA_WRITE_LIMIT))
+                return true;
+
+            _lastWrite = millis();
+            saveData(true);
+
+            // statistic
+            _snapshotSaves++;
+            _snapshotSaveMax = MAX(_snapshotSaveMax, _saveDuration);
 
+            logBegin();
+            logInfoP("Save snapshot to flash completed (%ius, max %ius)", _saveDuration, _snapshotSaveMax);
+            logEnd();
+            return true;
+        }
+
+        /**
+         * Build the layout of the snapshot (module headers) for the current modules
+         */
+        void Default::buildSnapshot()
+        {
+            uint16_t dataSize = 0;
+            for (uint8_t i = 0; i < openknx.modules.count; i++)
+            {
+                const uint16_t moduleSize = openknx.modules.list[i]->flashSize();
+                if (moduleSize > 0)
+                    dataSize += blockLength(OPENKNX_FLASH_FORMAT, moduleSize);
+            }
+
+            if (_snapshot == nullptr || dataSize != _snapshotSize)
+            {
+                delete[] _snapshot;
+                _snapshot = new uint8_t[dataSize];
+                _snapshotSize = dataSize;
+            }
+
+            uint16_t offset = 0;
+            for (uint8_t i = 0; i < openknx.modules.count; i++)
+            {
+                const uint16_t moduleSize = openknx.modules.list[i]->flashSize();
+                _snapshotOffset[i] = 0;
+                if (moduleSize == 0)
+                    continue;
+
+                // padding is filled once, the module data is written by refreshSnapshot
+                memset(_snapshot + offset, FLASH_DATA_FILLBYTE, blockLength(OPENKNX_FLASH_FORMAT, moduleSize));
+                _snapshot[offset] = openknx.modules.ids[i];
+                memcpy(_snapshot + offset + FLASH_DATA_MODULE_ID_LEN, &moduleSize, FLASH_DATA_SIZE_LEN);
+                _snapshotOffset[i] = offset + blockHeaderLength(OPENKNX_FLASH_FORMAT);
+                offset += blockLength(OPENKNX_FLASH_FORMAT, moduleSize);
+            }
+
+            _snapshotModule = 0;
+            _snapshotPending = true;
+            logDebugP("Snapshot with %i bytes", dataSize);
+        }
+
+        /**
+         * Serialize one module into the snapshot
+         * @return false if the layout of the module has changed
+         */
+        bool Default::refreshSnapshot(uint8_t index)
+        {
+            const uint16_t moduleSize = openknx.modules.list[index]->flashSize();
+            if (_snapshotOffset[index] == 0)
+                return moduleSize == 0;
+
+            const uint16_t offset = _snapshotOffset[index];
+            if (memcmp(_snapshot + offset - blockHeaderLength(OPENKNX_FLASH_FORMAT) + FLASH_DATA_MODULE_ID_LEN, &moduleSize, FLASH_DATA_SIZE_LEN))
+                return false;
+
+            const uint32_t start = micros();
+            _writeBuffer = _snapshot;
+            _currentWriteAddress = offset;
+            _maxWriteAddress = offset + moduleSize;
+            openknx.modules.list[index]->writeFlash();
+            writeFilldata();
+            _writeBuffer = nullptr;
+            _snapshotRefreshMax = MAX(_snapshotRefreshMax, micros() - start);
+            return true;
+        }
+
+        void Default::refreshSnapshot()
+        {
+            if (_snapshot == nullptr)
+                buildSnapshot();
+
+            uint8_t i = 0;
+            while (i < openknx.modules.count)
+            {
+                // layout changed: start again
+                if (!refreshSnapshot(i))
+                {
+                    buildSnapshot();
+                    i = 0;
+                    continue;
+                }
+                i++;
+            }
+
+            _snapshotModule = 0;
+            _snapshotPending = false;
+            _snapshotRefresh = millis();
+        }
+
+        void Default::loop()
+        {
+            // the snapshot is built after all lazy modules are restored
+            if (_pendingCount > 0)
+                return;
+
+            // complete refresh every OPENKNX_FLASH_SNAPSHOT_INTERVAL, one module per call
+            if (!_snapshotPending && _snapshot != nullptr && !delayCheck(_snapshotRefresh, OPENKNX_FLASH_SNAPSHOT_INTERVAL))
+                return;
+
+            if (_snapshot == nullptr)
+                buildSnapshot();
+
+            if (_snapshotModule == 0)
+                _snapshotCycle = millis();
+
+            if (_snapshotModule < openknx.modules.count)
+            {
+                if (!refreshSnapshot(_snapshotModule))
+                {
+                    buildSnapshot();
+                    return;
+                }
+                _snapshotModule++;
+            }
+
+            if (_snapshotModule >= openknx.modules.count)
+            {
+                _snapshotModule = 0;
+                _snapshotPending = false;
+                _snapshotRefresh = _snapshotCycle;
+            }
+        }
+
+        void Default::showSnapshot()
+        {
+            logBegin();
+            logInfoP("Snapshot: %i bytes%s", _snapshotSize, _snapshotPending ? " (pending)" : "");
+            logIndentUp();
+            logInfoP("Refreshed: %ims ago", millis() - _snapshotRefresh);
+            logInfoP("Refresh per module: max %ius", _snapshotRefreshMax);
+            logInfoP("Save: %i times, max %ius", _snapshotSaves, _snapshotSaveMax);
             logIndentDown();
             logEnd();
         }
+#endif
 
         uint8_t *Default::currentFlash()
         {
             return openknx.openknxFlash.flashAddress() + _currentReadAddress;
         }
 
-        uint16_t Default::calcChecksum(uint8_t *data, uint16_t size)
+        uint32_t Default::calcChecksum(uint8_t format, const uint8_t *data, uint16_t size, uint32_t checksum /* = 0 */)
         {
-            uint16_t sum = 0;
+            if (format >= 2)
+                return calcCrc32(checksum, data, size);
 
+            uint16_t sum = checksum;
             for (uint16_t i = 0; i < size; i++)
                 sum = sum + data[i];
 
             return sum;
         }
 
-        bool Default::verifyChecksum(uint8_t *data, uint16_t size, uint16_t checksum)
+        bool Default::verifyChecksum(uint8_t format, const uint8_t *data, uint16_t size, uint32_t checksum)
+        {
+            // logInfoP("verifyChecksum %i == %i", checksum, calcChecksum(format, data, size));
+            return checksum == calcChecksum(format, data, size);
+        }
+
+        void Default::writeChecksum()
         {
-            // logInfoP("verifyChecksum %i == %i", checksum, calcChecksum(data, size));
-            return checksum == calcChecksum(data, size);
+            const uint32_t checksum = _checksum;
+            if (OPENKNX_FLASH_FORMAT == 1)
+                writeWord(checksum);
+            else
+                writeInt(checksum);
         }
 
         void Default::write(uint8_t *buffer, uint16_t size)
@@ -387,9 +973,14 @@ namespace OpenKNX
                 return;
             }
 
-            for (uint16_t i = 0; i < size; i++)
-                _checksum += buffer[i];
+            _checksum = calcChecksum(OPENKNX_FLASH_FORMAT, buffer, size, _checksum);
 
+            if (_writeBuffer != nullptr)
+            {
+                memcpy(_writeBuffer + _currentWriteAddress, buffer, size);
+                _currentWriteAddress += size;
+                return;
+            }
             _currentWriteAddress = openknx.openknxFlash.write(_currentWriteAddress, buffer, size);
         }
 
@@ -401,9 +992,17 @@ namespace OpenKNX
                 return;
             }
 
-            for (uint16_t i = 0; i < size; i++)
-                _checksum += value;
+            uint8_t fill[16];
+            memset(fill, value, sizeof(fill));
+            for (uint16_t i = 0; i < size; i += sizeof(fill))
+                _checksum = calcChecksum(OPENKNX_FLASH_FORMAT, fill, MIN(sizeof(fill), (size_t)(size - i)), _checksum);
 
+            if (_writeBuffer != nullptr)
+            {
+                memset(_writeBuffer + _currentWriteAddress, value, size);
+                _currentWriteAddress += size;
+                return;
+            }
             _currentWriteAddress = openknx.openknxFlash.write(_currentWriteAddress, value, size);
         }
 
@@ -447,6 +1046,28 @@ namespace OpenKNX
             write((uint8_t)FLASH_DATA_FILLBYTE, fillSize);
         }
 
+        /**
+         * Fill up to the next aligned position after length written bytes (v2)
+         */
+        void Default::writePadding(uint32_t length)
+        {
+            const uint8_t padSize = padLength(OPENKNX_FLASH_FORMAT, length);
+            if (padSize == 0)
+                return;
+
+            _maxWriteAddress = MAX(_maxWriteAddress, _currentWriteAddress + padSize);
+            write((uint8_t)FLASH_DATA_FILLBYTE, padSize);
+        }
+
+        bool Default::alignedView(const uint8_t *data, uint8_t alignment)
+        {
+            if ((uintptr_t)data % alignment == 0)
+                return true;
+
+            logErrorP("View at %i is not aligned to %i bytes", data - openknx.openknxFlash.flashAddress(), alignment);
+            return false;
+        }
+
         uint8_t *Default::read(uint16_t size /* = 1 */)
         {
             _currentReadAddress += size;
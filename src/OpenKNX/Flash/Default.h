@@ -1,10 +1,16 @@
 #pragma once
 #include "OpenKNX/Flash/Driver.h"
+#include "OpenKNX/defines.h"
+#include <type_traits>
 
 #ifndef FLASH_DATA_WRITE_LIMIT
     #define FLASH_DATA_WRITE_LIMIT 180000 // 3 Minutes delay
 #endif
 
+#ifndef OPENKNX_FLASH_SNAPSHOT_INTERVAL
+    #define OPENKNX_FLASH_SNAPSHOT_INTERVAL 1000
+#endif
+
 #define FLASH_DATA_FILLBYTE 0xFF
 
 /*
@@ -90,13 +96,53 @@ Intro for Identification (and possible versioning later).
 */
 #define FLASH_DATA_INIT_LEN 4
 
+/**
+Format v2: CHK is a CRC-32 (uint32_t, 4 bytes) instead of the additive uint16_t sum, which does not
+detect reordered or swapped bytes. This also applies to the CHK of delta records.
+VERSION is replaced by a monotonic sequence number SEQ (uint32_t), the slot with the highest SEQ is the newest.
+All fields and the module data are aligned to FLASH_DATA_ALIGN bytes (relative to the slot), PAD is FLASH_DATA_FILLBYTE.
+> FLASH_STORAGE_DATA :=  DATA[$SIZE] ; APP[4] ; SIZE[2] ; PAD[2] ; SEQ[4] ; CHK[4] ; INIT[4]
+> INIT :=  'O' ; 'K' ; 'V' ; 0x02
+Both formats can be read, the format written is defined by OPENKNX_FLASH_FORMAT.
+Note: Firmwares without support of v2 do not find data written in v2.
+*/
+#define FLASH_DATA_INIT_V2 39209807 /* 4F 4B 56 02 */
+#define FLASH_DATA_CHK_V2_LEN 4
+#define FLASH_DATA_SEQUENCE_LEN 4
+#define FLASH_DATA_PAD_V2_LEN 2
+#define FLASH_DATA_ALIGN 4
+
+#ifndef OPENKNX_FLASH_FORMAT
+    #define OPENKNX_FLASH_FORMAT 2
+#endif
+
 /**
  * A version for dual write support (on SAMD disabled)
  */
 #define FLASH_DATA_VERSION 1
 
-/** Overall fixed-size of the non-module-data part */
+/** Overall fixed-size of the non-module-data part (v1) */
 #define FLASH_DATA_META_LEN (FLASH_DATA_APP_LEN + FLASH_DATA_SIZE_LEN + FLASH_DATA_VERSION + FLASH_DATA_CHK_LEN + FLASH_DATA_INIT_LEN)
+#define FLASH_DATA_META_V2_LEN (FLASH_DATA_APP_LEN + FLASH_DATA_SIZE_LEN + FLASH_DATA_PAD_V2_LEN + FLASH_DATA_SEQUENCE_LEN + FLASH_DATA_CHK_V2_LEN + FLASH_DATA_INIT_LEN)
+
+/**
+ * The flash is divided into OPENKNX_FLASH_SLOTS slots (aligned to sectors) used as a ring:
+ * each full save is written to the slot after the active one, so the writes are spread over all slots.
+ * The newest valid slot (by SEQ, in v1 by VERSION) is loaded. The VERSION of v1 is the lower byte of the sequence, so saves
+ * of both formats are compared by it and the 32 bit sequence is continued from the newest v2 save.
+ * On RP2040 the next slot is erased in advance, so a save on power loss only needs to program the flash.
+ *
+ * > |<- SLOT 0 ->|<- SLOT 1 ->| ... |<- SLOT N-1 ->| the_end
+ *
+ * The last slot ends at the_end, so data saved with one slot is still found (if it fits into a slot).
+ */
+#ifndef OPENKNX_FLASH_SLOTS
+    #ifdef ARDUINO_ARCH_RP2040
+        #define OPENKNX_FLASH_SLOTS 2
+    #else
+        #define OPENKNX_FLASH_SLOTS 1
+    #endif
+#endif
 
 //
 // ==== FLASH_STORAGE_DATA - DATA ====
@@ -115,13 +161,17 @@ Intro for Identification (and possible versioning later).
  * > MODULE	  := MOD_META[3] ; MOD_DATA[MOD_SIZE]
  * > MOD_META := MOD_ID[1] ; MOD_SIZE[2]
  *
+ * Format v2 aligns MOD_DATA and the following MODULE to FLASH_DATA_ALIGN bytes,
+ * so a module can access its data in place (see Default::readView):
+ * > MODULE	  := MOD_META[3] ; PAD[1] ; MOD_DATA[MOD_SIZE] ; PAD[0-3]
+ *
  * MOD_ID	:= uint8_t
  *   Identification of ModuleType as in knxprod.
  *   Allows different ordering of modules in storage.
  *
  * MOD_SIZE	:= uint16_t
  *   Define the length of MOD_DATA and position of following MODULE-block:
- *   &(MODULE[i+1]) := &(MODULE[i]) + sizeof(MOD_META) + MOD_SIZE
+ *   &(MODULE[i+1]) := &(MODULE[i]) + sizeof(MOD_META) + MOD_SIZE (v2: + PAD)
  *
  * MOD_DATA	:= uint8_t[$MOD_SIZE}
  *   Content ist defined by the module (referenced in MOD_ID) only.
@@ -140,8 +190,37 @@ Intro for Identification (and possible versioning later).
 
 // TODO check using #define FLASH_DATA_MODULE_SIZE_LEN FLASH_DATA_SIZE_LEN
 
+//
+// ==== FLASH_STORAGE_DATA - DELTA RECORDS (OPENKNX_FLASH_DELTA) ====
+//
+
+/*
+ * In delta mode a save only appends the blocks of changed modules as records to the free space
+ * in front of DATA. DATA and META are only written by a full save, which also removes all records.
+ * A full save is done, if the records do not fit anymore (compaction) or the modules have changed.
+ *
+ * > |<- RECORD ->|<- RECORD ->| ... FILLBYTE ... |<- DATA[SIZE] ->|<- META ->| the_end
+ * > RECORD := MARK[1] ; MOD_ID[1] ; MOD_SIZE[2] ; MOD_DATA[MOD_SIZE] ; CHK[2/4]
+ * > RECORD := MARK[1] ; MOD_ID[1] ; MOD_SIZE[2] ; MOD_DATA[MOD_SIZE] ; PAD[0-3] ; CHK[4] (v2)
+ *
+ * MARK := FLASH_DATA_DELTA_MARK
+ *   FLASH_DATA_FILLBYTE marks the end of the records (erased flash).
+ *
+ * CHK := checksum over MOD_ID, MOD_SIZE, MOD_DATA and PAD (in the format of the slot)
+ *   A record with an invalid checksum (partial write) ends the records and forces
+ *   a full save on the next save.
+ *
+ * On load the last record of a module replaces the block of the module in DATA.
+ * Firmwares without delta mode only read DATA (state of the last full save).
+ */
+#define FLASH_DATA_DELTA_MARK 0xA5
+#define FLASH_DATA_DELTA_MARK_LEN 1
+#define FLASH_DATA_DELTA_HEAD_LEN (FLASH_DATA_DELTA_MARK_LEN + FLASH_DATA_MODULE_ID_LEN + FLASH_DATA_SIZE_LEN)
+
 namespace OpenKNX
 {
+    class Module;
+
     namespace Flash
     {
         /**
@@ -165,15 +244,26 @@ namespace OpenKNX
              * 1a) check for expected INIT per slot
              * 1b) check APP for matching version
              * 1c) read the size of data
-             * 1d) read version
+             * 1d) read sequence (v1: version)
              * 1e) validate checksum
              * 2)  check is a valid slot available
-             * 3)  select slot with higher version
-             * 4)  load module data
-             * 5)  empty load (init) for the remaining modules
+             * 3)  select slot with highest sequence
+             * 4)  locate module data (and newer delta records)
+             * 5)  load module data (modules with restoreLazy() later by restore() or restoreNext())
+             * 6)  empty load (init) for the remaining modules
              */
             void load();
 
+            /**
+             * Restore the data of a lazy module now (nothing happens if already restored)
+             */
+            void restore(Module *module);
+
+            /**
+             * Restore the next pending lazy module (background restore after the startup delay)
+             */
+            void restoreNext();
+
             /**
              * TODO extend documentation
              *
@@ -183,11 +273,39 @@ namespace OpenKNX
              * 3) write DATA: data and fill unused requested space (for all modules)
              * 4) write APP
              * 5) write SIZE
-             * 6) write VERSION
+             * 6) write SEQ (v1: VERSION)
              * 7) write CHK
              * 8) write INIT
+             *
+             * In delta mode (OPENKNX_FLASH_DELTA) only the changed modules are appended as records, as long as they fit.
+             * With OPENKNX_FLASH_ASYNC the data is written in steps from the loop, use flush() if it must be written now.
              */
             void save(bool force = false);
+
+            /**
+             * Complete the writing of the last save (OPENKNX_FLASH_ASYNC), e.g. before a restart
+             */
+            void flush();
+
+#ifdef OPENKNX_FLASH_SNAPSHOT
+            /**
+             * Write the pre-serialized snapshot of all modules to the (erased) next slot.
+             * Used on power loss, as only the RAM image needs to be written.
+             * @return false if no complete snapshot is available (use save())
+             */
+            bool saveSnapshot();
+
+            /**
+             * Serialize all modules into the snapshot now. Can be called by a module after important changes.
+             */
+            void refreshSnapshot();
+
+            /**
+             * Refresh the snapshot in idle time: one module per call, all modules every OPENKNX_FLASH_SNAPSHOT_INTERVAL
+             */
+            void loop();
+            void showSnapshot();
+#endif
             void write(uint8_t *buffer, uint16_t size = 1);
             void write(uint8_t value, uint16_t size);
             void writeByte(uint8_t value);
@@ -196,6 +314,26 @@ namespace OpenKNX
             void writeFloat(float value);
             void writeLong(uint64_t value);
             void writeDouble(double value);
+
+            /**
+             * Write a trivially copyable value (e.g. a struct) in one call
+             */
+            template <typename T>
+            void writeObject(const T &value)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Flash: type must be trivially copyable");
+                write((uint8_t *)&value, sizeof(T));
+            }
+
+            /**
+             * Write an array of trivially copyable values (e.g. a state table) in one call
+             */
+            template <typename T>
+            void writeArray(const T *values, uint16_t count)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Flash: type must be trivially copyable");
+                write((uint8_t *)values, sizeof(T) * count);
+            }
             uint8_t *read(uint16_t size = 1);
             uint8_t readByte();
             uint16_t readWord();
@@ -203,34 +341,119 @@ namespace OpenKNX
             float readFloat();
             uint64_t readLong();
             double readDouble();
+
+            /**
+             * Read a copy of a trivially copyable value
+             */
+            template <typename T>
+            T readObject()
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Flash: type must be trivially copyable");
+                T value;
+                memcpy(&value, read(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            /**
+             * Access count values in the flash without copy (valid until the next save).
+             * In format v2 the module data starts aligned to FLASH_DATA_ALIGN bytes,
+             * so the view is aligned, if the values are at a multiple of alignof(T) in the module data.
+             * @return nullptr if the data is not aligned for T (use readObject)
+             */
+            template <typename T>
+            const T *readView(uint16_t count = 1)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Flash: type must be trivially copyable");
+                const uint8_t *data = read(sizeof(T) * count);
+                return alignedView(data, alignof(T)) ? (const T *)data : nullptr;
+            }
             uint16_t firmwareVersion();
             uint32_t lastWrite();
 
+            /**
+             * Checksum of the format (v1: additive uint16_t, v2: CRC-32)
+             * @param checksum the result of the previous call to continue the calculation
+             */
+            static uint32_t calcChecksum(uint8_t format, const uint8_t *data, uint16_t size, uint32_t checksum = 0);
+
           private:
-            bool *loadedModules = nullptr;
-            bool _activeSlot = false; // false = A & true = B
+            bool _loadedModules[OPENKNX_MAX_MODULES] = {};
+            // lazy modules waiting for readFlash()
+            bool _pendingModules[OPENKNX_MAX_MODULES] = {};
+            uint8_t _pendingCount = 0;
+            // relative address and size of the current data of each module (0 = no data)
+            uint32_t _moduleAddress[OPENKNX_MAX_MODULES] = {};
+            uint16_t _moduleSize[OPENKNX_MAX_MODULES] = {};
+#ifdef OPENKNX_FLASH_DELTA
+            // next record and start of DATA in the active slot
+            uint32_t _deltaAddress = 0;
+            uint32_t _deltaEnd = 0;
+            // records can be appended (false forces a full save)
+            bool _deltaAppendable = false;
+            void loadDeltaRecords(uint32_t end);
+            bool saveDelta();
+#endif
+            uint8_t _activeSlot = 0;
+            // sequence number of the active slot
+            uint32_t _sequence = 0;
             uint32_t _lastWrite = 0;
             uint16_t _lastFirmwareNumber = 0;
             uint16_t _lastFirmwareVersion = 0;
-            uint16_t _checksum = 0;
+            uint32_t _checksum = 0;
+            // format of the active slot (0 = no data)
+            uint8_t _format = 0;
             uint32_t _currentWriteAddress = 0;
             uint32_t _currentReadAddress = 0;
             uint32_t _maxWriteAddress = 0;
+            // module data is written to this buffer instead of the flash
+            uint8_t *_writeBuffer = nullptr;
+            // duration of the last full save without erase (µs)
+            uint32_t _saveDuration = 0;
+#ifdef OPENKNX_FLASH_SNAPSHOT
+            uint8_t *_snapshot = nullptr;
+            uint16_t _snapshotSize = 0;
+            // offset of the module data in the snapshot (0 = no data)
+            uint16_t _snapshotOffset[OPENKNX_MAX_MODULES] = {};
+            // next module to refresh and start of the current/last complete refresh
+            uint8_t _snapshotModule = 0;
+            uint32_t _snapshotCycle = 0;
+            uint32_t _snapshotRefresh = 0;
+            // not all modules are serialized since the layout was built
+            bool _snapshotPending = true;
+            uint32_t _snapshotRefreshMax = 0;
+            uint32_t _snapshotSaveMax = 0;
+            uint32_t _snapshotSaves = 0;
+            void buildSnapshot();
+            bool refreshSnapshot(uint8_t index);
+#endif
+            void saveData(bool snapshot);
             void writeFilldata();
+            void writePadding(uint32_t length);
+            bool alignedView(const uint8_t *data, uint8_t alignment);
             void loadModuleData();
             void initUnloadedModules();
-            bool validateSlot(bool slot);
-            void eraseSlot(bool slot);
-            uint8_t nextVersion();
-            uint8_t slotVersion(bool slot);
-            uint16_t slotOffset(bool slot);
-            uint16_t slotSize();
-            bool nextSlot();
+            void restoreModule(uint8_t index);
+            void restoreModules();
+            bool validateSlot(uint8_t slot);
+            uint8_t slotFormat(uint8_t slot);
+            static uint8_t checksumLength(uint8_t format);
+            static uint8_t metaLength(uint8_t format);
+            static uint8_t padLength(uint8_t format, uint32_t length);
+            static uint8_t blockHeaderLength(uint8_t format);
+            static uint32_t blockLength(uint8_t format, uint16_t moduleSize);
+            static bool newerSlot(uint8_t format, uint32_t sequence, uint8_t otherFormat, uint32_t otherSequence);
+            static uint32_t extendSequence(uint32_t version, uint32_t sequence);
+            void eraseSlot(uint8_t slot, bool async = false);
+            void commit(bool async);
+            uint32_t slotSequence(uint8_t slot);
+            uint32_t slotOffset(uint8_t slot);
+            uint32_t slotSize();
+            uint8_t nextSlot();
             uint32_t readOffset();
             uint32_t writeOffset();
             uint8_t *currentFlash();
-            uint16_t calcChecksum(uint8_t *data, uint16_t size);
-            bool verifyChecksum(uint8_t *data, uint16_t size, uint16_t checksum);
+            bool verifyChecksum(uint8_t format, const uint8_t *data, uint16_t size, uint32_t checksum);
+            void writeChecksum();
             std::string logPrefix();
         };
     } // namespace Flash
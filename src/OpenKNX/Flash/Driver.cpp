@@ -7,6 +7,14 @@ extern uint32_t __data_start__;
 extern uint32_t __data_end__;
 #elif defined(ARDUINO_ARCH_ESP32)
 // ToDo: Implementation for ESP32
+#elif defined(OPENKNX_NATIVE)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+
+    #ifndef OPENKNX_NATIVE_FLASH_DIR
+        #define OPENKNX_NATIVE_FLASH_DIR "."
+    #endif
 #else
 extern uint32_t _EEPROM_start;
 extern uint32_t _FS_start;
@@ -62,6 +70,37 @@ namespace OpenKNX
             _sectorSize = FLASH_SECTOR_SIZE;
             _pageSize = FLASH_PAGE_SIZE;
             _endFree = (uint32_t)(&_FS_start) - 0x10000000lu;
+    #elif defined(OPENKNX_NATIVE)
+            // Host: the flash is emulated by a memory-mapped file (<OPENKNX_NATIVE_FLASH_DIR>/<id>.flash)
+            _sectorSize = 4096;
+            _pageSize = 256;
+            _startFree = 0;
+            _endFree = _size;
+
+            const std::string path = std::string(OPENKNX_NATIVE_FLASH_DIR) + "/" + id + ".flash";
+            const int file = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+            if (file < 0)
+                openknx.hardware.fatalError(FATAL_FLASH_PARAMETERS, "Flash: Unable to open flash file");
+
+            // a new file is initialized as erased flash
+            const off_t fileSize = lseek(file, 0, SEEK_END);
+            if (fileSize < (off_t)_size)
+            {
+                if (ftruncate(file, _size) != 0)
+                    openknx.hardware.fatalError(FATAL_FLASH_PARAMETERS, "Flash: Unable to resize flash file");
+
+                _mmap = (uint8_t *)mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+                if (_mmap != MAP_FAILED)
+                    memset(_mmap + fileSize, 0xFF, _size - fileSize);
+            }
+            else
+            {
+                _mmap = (uint8_t *)mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+            }
+            close(file);
+
+            if (_mmap == MAP_FAILED)
+                openknx.hardware.fatalError(FATAL_FLASH_PARAMETERS, "Flash: Unable to map flash file");
     #endif
             logDebugP("flash at 0x%08X with %i size", _offset, _size);
 #endif
@@ -82,6 +121,8 @@ namespace OpenKNX
                 openknx.hardware.fatalError(FATAL_FLASH_PARAMETERS, "Flash: Offset unaligned");
             if (_size > _endFree)
                 openknx.hardware.fatalError(FATAL_FLASH_PARAMETERS, "Flash: End behind free flash");
+            if (_sectorSize / _pageSize > 32)
+                openknx.hardware.fatalError(FATAL_FLASH_PARAMETERS, "Flash: Too many pages per sector");
 #ifdef ARDUINO_ARCH_ESP32
             if (_offset % SPI_FLASH_MMU_PAGE_SIZE)
                 openknx.hardware.fatalError(FATAL_FLASH_PARAMETERS, "Flash: Offset unaligned (SPI_FLASH_MMAP_DATA)");
@@ -97,7 +138,7 @@ namespace OpenKNX
         {
 #if defined(ARDUINO_ARCH_SAMD)
             return (uint8_t *)_offset;
-#elif defined(ARDUINO_ARCH_ESP32)
+#elif defined(ARDUINO_ARCH_ESP32) || defined(OPENKNX_NATIVE)
             return _mmap;
 #else
             return (uint8_t *)XIP_BASE + _offset;
@@ -136,69 +177,321 @@ namespace OpenKNX
 
         bool Driver::needEraseSector(uint16_t sector)
         {
-            for (size_t i = 0; i < _sectorSize; i++)
-                if ((flashAddress() + sector * _sectorSize)[i] != 0xFF)
+            return !erased(uncachedAddress() + sector * _sectorSize, _sectorSize);
+        }
+
+        /*
+         * Checks 4 words per step, the loop is left on the first block with a difference
+         */
+        bool Driver::erased(const uint8_t *data, uint32_t size)
+        {
+            const uint32_t *words = (const uint32_t *)data;
+            const uint32_t count = size / 4;
+            uint32_t i = 0;
+            for (; i + 4 <= count; i += 4)
+                if ((words[i] & words[i + 1] & words[i + 2] & words[i + 3]) != 0xFFFFFFFF)
+                    return false;
+
+            for (; i < count; i++)
+                if (words[i] != 0xFFFFFFFF)
+                    return false;
+
+            return true;
+        }
+
+        bool Driver::needErase(const uint8_t *flash, const uint8_t *data, uint32_t size)
+        {
+            // a bit set in data, but not in flash, can only be written after an erase
+            const uint32_t *flashWords = (const uint32_t *)flash;
+            const uint32_t *dataWords = (const uint32_t *)data;
+            const uint32_t count = size / 4;
+            uint32_t i = 0;
+            for (; i + 4 <= count; i += 4)
+                if ((dataWords[i] & ~flashWords[i]) |
+                    (dataWords[i + 1] & ~flashWords[i + 1]) |
+                    (dataWords[i + 2] & ~flashWords[i + 2]) |
+                    (dataWords[i + 3] & ~flashWords[i + 3]))
+                    return true;
+
+            for (; i < count; i++)
+                if (dataWords[i] & ~flashWords[i])
                     return true;
 
             return false;
         }
 
-        bool Driver::needWriteSector()
+        /*
+         * Address to check the flash content, which does not pollute the XIP cache on RP2040
+         */
+        const uint8_t *Driver::uncachedAddress()
         {
-            return memcmp(_buffer, flashAddress() + _bufferSector * _sectorSize, _sectorSize);
+#ifdef ARDUINO_ARCH_RP2040
+            return (const uint8_t *)XIP_NOCACHE_NOALLOC_BASE + _offset;
+#else
+            return flashAddress();
+#endif
         }
 
-        bool Driver::needEraseForBuffer()
+        /*
+         * Bits of the pages touched by [position, position + size) within a sector
+         */
+        uint32_t Driver::pageMask(uint16_t position, uint16_t size)
         {
-            uint8_t flashByte;
-            uint8_t bufferByte;
-            for (size_t i = 0; i < _sectorSize; i++)
-            {
-                flashByte = (flashAddress() + _bufferSector * _sectorSize)[i];
-                bufferByte = _buffer[i];
+            const uint16_t first = position / _pageSize;
+            const uint16_t last = (position + size - 1) / _pageSize;
+            return ((2u << last) - 1) & ~((1u << first) - 1);
+        }
 
-                if (bufferByte != flashByte && (bufferByte & ~flashByte))
+        bool Driver::needEraseForBuffer(Sector &sector)
+        {
+            // unchanged pages are equal to the flash
+            const uint8_t *flash = uncachedAddress() + sector.sector * _sectorSize;
+            for (uint16_t page = 0; page < _sectorSize / _pageSize; page++)
+                if ((sector.dirty & (1u << page)) && needErase(flash + page * _pageSize, sector.buffer + page * _pageSize, _pageSize))
                     return true;
-            }
 
             return false;
         }
 
-        void Driver::loadSector(uint16_t sector, bool force /* = false */)
+        Driver::Sector &Driver::loadSector(uint16_t sector)
         {
-            // skip - already loaded and not force
-            if (!force && _buffer != nullptr && sector == _bufferSector)
-                return;
+            _cacheUse++;
+
+            // sequential writes
+            if (_current != nullptr && _current->sector == sector)
+            {
+                _current->used = _cacheUse;
+                return *_current;
+            }
+
+            // already loaded or least recently used
+            Sector *entry = &_cache[0];
+            for (uint8_t i = 0; i < OPENKNX_FLASH_CACHE_SECTORS; i++)
+            {
+                if (_cache[i].buffer != nullptr && _cache[i].sector == sector)
+                {
+                    _current = &_cache[i];
+                    _current->used = _cacheUse;
+                    return *_current;
+                }
+
+                if (_cache[i].used < entry->used)
+                    entry = &_cache[i];
+            }
 
             // load specific sector
             logTraceP("load buffer for sector %i", sector);
             logIndentUp();
 
-            // an other sector is loaded - commit before load
-            if (_buffer != nullptr && sector != _bufferSector)
-                commit();
+            // write back the replaced sector
+            if (entry->dirty)
+                writeSector(*entry);
 
             // initalize buffer for first time
-            if (_buffer == nullptr)
-                _buffer = new uint8_t[_sectorSize];
-
-            _bufferSector = sector;
-            memcpy(_buffer, flashAddress() + _bufferSector * _sectorSize, _sectorSize);
+            if (entry->buffer == nullptr)
+                entry->buffer = new uint8_t[_sectorSize];
+
+            entry->sector = sector;
+            entry->dirty = 0;
+            entry->used = _cacheUse;
+#ifdef OPENKNX_FLASH_ASYNC
+            entry->checked = false;
+            if (erasePending(sector))
+                memset(entry->buffer, 0xFF, _sectorSize);
+            else
+#endif
+                memcpy(entry->buffer, flashAddress() + sector * _sectorSize, _sectorSize);
+            _current = entry;
             logIndentDown();
+            return *entry;
         }
 
         void Driver::commit()
         {
-            // no sector loaded
-            if (_buffer == nullptr)
-                return;
-
             logTraceP("commit");
             logIndentUp();
-            writeSector();
+
+            // in order of the address
+            while (true)
+            {
+                Sector *next = nullptr;
+                for (uint8_t i = 0; i < OPENKNX_FLASH_CACHE_SECTORS; i++)
+                    if (_cache[i].dirty && (next == nullptr || _cache[i].sector < next->sector))
+                        next = &_cache[i];
+
+                if (next == nullptr)
+                    break;
+
+                writeSector(*next);
+            }
+
+#ifdef OPENKNX_FLASH_ASYNC
+            // sectors to erase without buffer
+            for (uint16_t i = 0; _erasePendingCount > 0 && i < _size / _sectorSize; i++)
+                if (takeErasePending(i))
+                    eraseSector(i);
+
+            if (_committing)
+                finishCommit();
+#endif
+
             logIndentDown();
         }
 
+#ifdef OPENKNX_FLASH_ASYNC
+        void Driver::commitAsync(CommitCallbackFunction callback /* = nullptr */)
+        {
+            // a running commit is continued, both callbacks are called at the end
+            if (_commitCallback != nullptr && callback != nullptr)
+            {
+                CommitCallbackFunction first = _commitCallback;
+                _commitCallback = [first, callback]() {
+                    first();
+                    callback();
+                };
+            }
+            else if (callback != nullptr)
+            {
+                _commitCallback = callback;
+            }
+
+            _committing = true;
+        }
+
+        void Driver::eraseAsync(uint16_t sector, uint16_t count /* = 1 */)
+        {
+            if (_erasePending == nullptr)
+                _erasePending = new uint8_t[(_size / _sectorSize + 7) / 8]();
+
+            for (uint16_t i = sector; i < sector + count; i++)
+            {
+                if (!erasePending(i))
+                {
+                    _erasePending[i / 8] |= 1 << (i % 8);
+                    _erasePendingCount++;
+                }
+
+                // the erase replaces the buffered content
+                for (uint8_t j = 0; j < OPENKNX_FLASH_CACHE_SECTORS; j++)
+                {
+                    if (_cache[j].buffer != nullptr && _cache[j].sector == i)
+                    {
+                        memset(_cache[j].buffer, 0xFF, _sectorSize);
+                        _cache[j].dirty = 0;
+                        _cache[j].checked = false;
+                    }
+                }
+            }
+        }
+
+        bool Driver::erasePending(uint16_t sector)
+        {
+            return _erasePendingCount > 0 && (_erasePending[sector / 8] & (1 << (sector % 8)));
+        }
+
+        bool Driver::takeErasePending(uint16_t sector)
+        {
+            if (!erasePending(sector))
+                return false;
+
+            _erasePending[sector / 8] &= ~(1 << (sector % 8));
+            _erasePendingCount--;
+            return true;
+        }
+
+        void Driver::finishCommit()
+        {
+            _committing = false;
+            CommitCallbackFunction callback = _commitCallback;
+            _commitCallback = nullptr;
+            if (callback != nullptr)
+                callback();
+        }
+
+        bool Driver::busy()
+        {
+            return _committing;
+        }
+
+        bool Driver::loop()
+        {
+            if (!_committing)
+                return false;
+
+            // write first, in order of the address
+            Sector *next = nullptr;
+            for (uint8_t i = 0; i < OPENKNX_FLASH_CACHE_SECTORS; i++)
+                if (_cache[i].dirty && (next == nullptr || _cache[i].sector < next->sector))
+                    next = &_cache[i];
+
+            if (next == nullptr)
+            {
+                // erase afterwards, so the old data (e.g. the previous slot) is kept until the new data is written
+                for (uint16_t i = 0; _erasePendingCount > 0 && i < _size / _sectorSize; i++)
+                {
+                    if (takeErasePending(i))
+                    {
+                        eraseSector(i);
+                        return true;
+                    }
+                }
+
+                finishCommit();
+                return false;
+            }
+
+            // the buffer contains the content after the erase, so it has to be done before the write
+            if (takeErasePending(next->sector))
+            {
+                eraseSector(next->sector);
+                next->checked = true;
+                return true;
+            }
+
+            if (!next->checked)
+            {
+                next->checked = true;
+                if (needEraseForBuffer(*next))
+                {
+                    eraseSector(next->sector);
+                    next->dirty = pageMask(0, _sectorSize);
+                    return true;
+                }
+            }
+
+            // program one page (unchanged pages are skipped)
+            while (next->dirty)
+            {
+                const uint16_t page = __builtin_ctz(next->dirty);
+                next->dirty &= ~(1u << page);
+                if (!memcmp(next->buffer + page * _pageSize, uncachedAddress() + next->sector * _sectorSize + page * _pageSize, _pageSize))
+                    continue;
+
+                logTraceP("write sector %i page %i", next->sector, page);
+    #if defined(ARDUINO_ARCH_RP2040)
+                noInterrupts();
+                rp2040.idleOtherCore();
+    #endif
+                writePages(*next, page, 1);
+    #if defined(ARDUINO_ARCH_RP2040)
+                rp2040.resumeOtherCore();
+                interrupts();
+    #endif
+                break;
+            }
+
+            if (!next->dirty)
+            {
+                next->checked = false;
+    #if defined(OPENKNX_NATIVE)
+                msync(flashAddress() + (next->sector * _sectorSize), _sectorSize, MS_SYNC);
+    #endif
+            }
+
+            return true;
+        }
+#endif
+
         uint32_t Driver::write(uint32_t relativeAddress, uint8_t value, uint32_t size /* = 1 */)
         {
             if (size <= 0)
@@ -207,7 +500,7 @@ namespace OpenKNX
             uint16_t sector = sectorOfRelativeAddress(relativeAddress);
 
             // load buffer if needed
-            loadSector(sector);
+            Sector &entry = loadSector(sector);
 
             // position in loaded buffer
             uint16_t bufferPosition = relativeAddress % _sectorSize;
@@ -221,8 +514,19 @@ namespace OpenKNX
             // determine how much must be stored within the sector.
             uint16_t writeSize = (writeMaxSize < size) ? writeMaxSize : size;
 
-            // write date to current buffer
-            memset(_buffer + bufferPosition, value, writeSize);
+            // write date to current buffer (only changes mark the pages dirty)
+            for (uint16_t i = 0; i < writeSize; i++)
+            {
+                if (entry.buffer[bufferPosition + i] != value)
+                {
+                    memset(entry.buffer + bufferPosition + i, value, writeSize - i);
+                    entry.dirty |= pageMask(bufferPosition + i, writeSize - i);
+#ifdef OPENKNX_FLASH_ASYNC
+                    entry.checked = false;
+#endif
+                    break;
+                }
+            }
 
             // write overhead in next sector
             if (overheadSize > 0)
@@ -239,7 +543,7 @@ namespace OpenKNX
             uint16_t sector = sectorOfRelativeAddress(relativeAddress);
 
             // load buffer if needed
-            loadSector(sector);
+            Sector &entry = loadSector(sector);
 
             // position in loaded buffer
             uint16_t bufferPosition = relativeAddress % _sectorSize;
@@ -253,8 +557,15 @@ namespace OpenKNX
             // determine how much must be stored within the sector.
             uint16_t writeSize = (writeMaxSize < size) ? writeMaxSize : size;
 
-            // write date to current buffer
-            memcpy(_buffer + bufferPosition, buffer, writeSize);
+            // write date to current buffer (only changes mark the pages dirty)
+            if (memcmp(entry.buffer + bufferPosition, buffer, writeSize))
+            {
+                memcpy(entry.buffer + bufferPosition, buffer, writeSize);
+                entry.dirty |= pageMask(bufferPosition, writeSize);
+#ifdef OPENKNX_FLASH_ASYNC
+                entry.checked = false;
+#endif
+            }
 
             // write overhead in next sector
             if (overheadSize > 0)
@@ -348,6 +659,20 @@ namespace OpenKNX
             {
                 eraseSector(i);
             }
+
+            // buffered sectors are outdated
+            for (uint8_t i = 0; i < OPENKNX_FLASH_CACHE_SECTORS; i++)
+            {
+                delete[] _cache[i].buffer;
+                _cache[i] = Sector();
+            }
+            _current = nullptr;
+
+#ifdef OPENKNX_FLASH_ASYNC
+            if (_erasePending != nullptr)
+                memset(_erasePending, 0, (_size / _sectorSize + 7) / 8);
+            _erasePendingCount = 0;
+#endif
         }
 
         void Driver::eraseSector(uint16_t sector)
@@ -374,37 +699,91 @@ namespace OpenKNX
             flash_range_erase((intptr_t)(_offset + (sector * _sectorSize)), _sectorSize);
             rp2040.resumeOtherCore();
             interrupts();
+#elif defined(OPENKNX_NATIVE)
+            memset(flashAddress() + (sector * _sectorSize), 0xFF, _sectorSize);
+            msync(flashAddress() + (sector * _sectorSize), _sectorSize, MS_SYNC);
 #endif
         }
 
-        void Driver::writeSector()
+        void Driver::writeSector(Sector &sector)
         {
-            if (!needWriteSector())
+#ifdef OPENKNX_FLASH_ASYNC
+            // the erase is done now, the buffer contains the content after the erase
+            if (takeErasePending(sector.sector))
+            {
+                eraseSector(sector.sector);
+                sector.dirty = pageMask(0, _sectorSize);
+            }
+            sector.checked = false;
+#endif
+
+            if (!sector.dirty)
             {
                 logTraceP("skip write sector, because no changes");
                 return;
             }
 
-            if (needEraseForBuffer())
+            const uint16_t pages = _sectorSize / _pageSize;
+            if (needEraseForBuffer(sector))
             {
-                eraseSector(_bufferSector);
+                eraseSector(sector.sector);
+                sector.dirty = pageMask(0, _sectorSize);
             }
 
-            logTraceP("write sector %i", _bufferSector);
-            // logHexTraceP(_buffer, _sectorSize);
+            logTraceP("write sector %i", sector.sector);
+            // logHexTraceP(sector.buffer, _sectorSize);
+
+#if defined(ARDUINO_ARCH_RP2040)
+            noInterrupts();
+            rp2040.idleOtherCore();
+#endif
+
+            // write changed pages only, consecutive pages at once to reduce write time
+            const uint8_t *flash = uncachedAddress() + sector.sector * _sectorSize;
+            uint16_t first = 0;
+            uint16_t count = 0;
+            for (uint16_t page = 0; page <= pages; page++)
+            {
+                if (page < pages && (sector.dirty & (1u << page)) && memcmp(sector.buffer + page * _pageSize, flash + page * _pageSize, _pageSize))
+                {
+                    if (count == 0)
+                        first = page;
+                    count++;
+                    continue;
+                }
+
+                if (count > 0)
+                    writePages(sector, first, count);
+                count = 0;
+            }
+
+#if defined(ARDUINO_ARCH_RP2040)
+            rp2040.resumeOtherCore();
+            interrupts();
+#elif defined(OPENKNX_NATIVE)
+            msync(flashAddress() + (sector.sector * _sectorSize), _sectorSize, MS_SYNC);
+#endif
+
+            sector.dirty = 0;
+        }
+
+        /*
+         * Program count pages of the buffer starting at page (the pages are erased or only bits are cleared)
+         */
+        void Driver::writePages(Sector &sector, uint16_t page, uint16_t count)
+        {
+            const uint32_t position = page * _pageSize;
+            const uint32_t size = count * _pageSize;
 
 #if defined(ARDUINO_ARCH_SAMD)
-            // logHexTraceP(_buffer, _sectorSize);
-            volatile uint32_t *src_addr = (volatile uint32_t *)_buffer;
-            volatile uint32_t *dst_addr = (volatile uint32_t *)(flashAddress() + (_bufferSector * _sectorSize));
+            volatile uint32_t *src_addr = (volatile uint32_t *)(sector.buffer + position);
+            volatile uint32_t *dst_addr = (volatile uint32_t *)(flashAddress() + (sector.sector * _sectorSize) + position);
 
             // Disable automatic page write
             NVMCTRL->CTRLB.bit.MANW = 1;
 
-            uint16_t size = _sectorSize / 4;
-
             // Do writes in pages
-            while (size)
+            for (uint16_t i = 0; i < count; i++)
             {
                 // Execute "PBC" Page Buffer Clear
                 NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMDEX_KEY | NVMCTRL_CTRLA_CMD_PBC;
@@ -413,12 +792,11 @@ namespace OpenKNX
                 }
 
                 // Fill page buffer
-                for (uint16_t i = 0; i < (_sectorSize / 16) && size; i++)
+                for (uint16_t j = 0; j < (_pageSize / 4); j++)
                 {
                     *dst_addr = *src_addr;
                     src_addr++;
                     dst_addr++;
-                    size--;
                 }
 
                 // Execute "WP" Write Page
@@ -428,56 +806,14 @@ namespace OpenKNX
                 }
             }
 #elif defined(ARDUINO_ARCH_ESP32)
-            // write smaller _pageSize to reduze write time
-            uint32_t currentPosition = 0;
-            uint32_t currentSize = 0;
-            while (currentPosition < _sectorSize)
-            {
-                while (memcmp(_buffer + currentPosition + currentSize, flashAddress() + (_bufferSector * _sectorSize) + currentPosition + currentSize, _pageSize))
-                {
-                    currentSize += _pageSize;
-
-                    // last
-                    if (currentPosition + currentSize == _sectorSize)
-                        break;
-                }
-
-                // Changes Found
-                if (currentSize > 0)
-                    spi_flash_write((size_t)(_offset + (_bufferSector * _sectorSize) + currentPosition), _buffer + currentPosition, currentSize);
-                // flash_range_program((intptr_t)(_offset + (_bufferSector * _sectorSize) + currentPosition), _buffer + currentPosition, currentSize);
-
-                currentPosition += currentSize + _pageSize;
-                currentSize = 0;
-            }
-
+            spi_flash_write((size_t)(_offset + (sector.sector * _sectorSize) + position), sector.buffer + position, size);
 #elif defined(ARDUINO_ARCH_RP2040)
-            noInterrupts();
-            rp2040.idleOtherCore();
-
-            // write smaller _pageSize to reduze write time
-            uint32_t currentPosition = 0;
-            uint32_t currentSize = 0;
-            while (currentPosition < _sectorSize)
-            {
-                while (memcmp(_buffer + currentPosition + currentSize, flashAddress() + (_bufferSector * _sectorSize) + currentPosition + currentSize, _pageSize))
-                {
-                    currentSize += _pageSize;
-
-                    // last
-                    if (currentPosition + currentSize == _sectorSize)
-                        break;
-                }
-
-                // Changes Found
-                if (currentSize > 0)
-                    flash_range_program((intptr_t)(_offset + (_bufferSector * _sectorSize) + currentPosition), _buffer + currentPosition, currentSize);
-
-                currentPosition += currentSize + _pageSize;
-                currentSize = 0;
-            }
-            rp2040.resumeOtherCore();
-            interrupts();
+            flash_range_program((intptr_t)(_offset + (sector.sector * _sectorSize) + position), sector.buffer + position, size);
+#elif defined(OPENKNX_NATIVE)
+            // emulate nor flash programming: bits can only be cleared
+            uint8_t *address = flashAddress() + (sector.sector * _sectorSize) + position;
+            for (uint32_t i = 0; i < size; i++)
+                address[i] &= sector.buffer[position + i];
 #endif
         }
     } // namespace Flash
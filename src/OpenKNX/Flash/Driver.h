@@ -1,11 +1,21 @@
 #pragma once
 #include <Arduino.h>
+#include <functional>
 #include <string>
 
+// Number of sectors buffered for writing (write-back cache, each needs one sector of RAM)
+#ifndef OPENKNX_FLASH_CACHE_SECTORS
+    #define OPENKNX_FLASH_CACHE_SECTORS 1
+#endif
+
 namespace OpenKNX
 {
     namespace Flash
     {
+#ifdef OPENKNX_FLASH_ASYNC
+        typedef std::function<void(void)> CommitCallbackFunction;
+#endif
+
         class Driver
         {
           protected:
@@ -18,21 +28,52 @@ namespace OpenKNX
             uint16_t _sectorSize = 0;
             uint16_t _pageSize = 0;
 
-            uint8_t *_buffer = nullptr;
-            uint16_t _bufferSector = 0;
-#ifdef ARDUINO_ARCH_ESP32
+            /*
+             * A sector buffered for writing. Only the pages changed in the buffer (dirty) are
+             * compared and programmed on commit.
+             */
+            struct Sector
+            {
+                uint8_t *buffer = nullptr;
+                uint16_t sector = 0;
+                // bit per page changed since load/commit
+                uint32_t dirty = 0;
+                // last use (least recently used sector is written back first)
+                uint32_t used = 0;
+#ifdef OPENKNX_FLASH_ASYNC
+                // erase check for the dirty pages done (async commit)
+                bool checked = false;
+#endif
+            };
+            Sector _cache[OPENKNX_FLASH_CACHE_SECTORS];
+            Sector *_current = nullptr;
+            uint32_t _cacheUse = 0;
+#if defined(ARDUINO_ARCH_ESP32) || defined(OPENKNX_NATIVE)
             uint8_t *_mmap = nullptr;
 #endif
 
-            void writeSector();
-            bool needWriteSector();
-            bool needEraseForBuffer();
+            void writeSector(Sector &sector);
+            void writePages(Sector &sector, uint16_t page, uint16_t count);
+            bool needEraseForBuffer(Sector &sector);
             bool needEraseSector(uint16_t sector = 0);
             uint16_t sectorOfRelativeAddress(uint32_t relativeAddress);
+            uint32_t pageMask(uint16_t position, uint16_t size);
+            const uint8_t *uncachedAddress();
 
             void validateParameters();
 
-            void loadSector(uint16_t sector, bool force = false);
+            Sector &loadSector(uint16_t sector);
+
+#ifdef OPENKNX_FLASH_ASYNC
+            bool _committing = false;
+            CommitCallbackFunction _commitCallback = nullptr;
+            // bit per sector to be erased
+            uint8_t *_erasePending = nullptr;
+            uint16_t _erasePendingCount = 0;
+            bool erasePending(uint16_t sector);
+            bool takeErasePending(uint16_t sector);
+            void finishCommit();
+#endif
 
           public:
 #ifdef ARDUINO_ARCH_ESP32
@@ -47,12 +88,39 @@ namespace OpenKNX
             uint8_t *flashAddress();
 
             void commit();
+#ifdef OPENKNX_FLASH_ASYNC
+            /*
+             * Write the buffered sectors and pending erases in steps (see loop). The callback is called when
+             * all is written. commit() completes all steps at once (e.g. on power loss).
+             */
+            void commitAsync(CommitCallbackFunction callback = nullptr);
+
+            /*
+             * Erase the sectors in steps with the next commit. The buffered content of these sectors is discarded.
+             */
+            void eraseAsync(uint16_t sector, uint16_t count = 1);
+
+            /*
+             * Execute one step of the commit: erase one sector or program one page
+             * @return true if more steps are pending
+             */
+            bool loop();
+            bool busy();
+#endif
             uint32_t size();
             uint32_t startFree();
             uint32_t endFree();
             uint32_t sectorSize();
             uint32_t startOffset();
 
+            /*
+             * Word-wise checks of flash content (data and size aligned to 4 bytes)
+             * erased: all bytes are 0xFF
+             * needErase: data can not be programmed over flash without an erase
+             */
+            static bool erased(const uint8_t *data, uint32_t size);
+            static bool needErase(const uint8_t *flash, const uint8_t *data, uint32_t size);
+
             uint32_t write(uint32_t relativeAddress, uint8_t value, uint32_t size = 1);
             uint32_t write(uint32_t relativeAddress, uint8_t *buffer, uint32_t size = 1);
 
@@ -7,6 +7,7 @@
 #if defined(ARDUINO_ARCH_RP2040) && defined(USE_TP_RX_QUEUE) && defined(USE_KNX_DMA_UART) && defined(USE_KNX_DMA_IRQ) && (MASK_VERSION == 0x07B0 || MASK_VERSION == 0x091A)
 void __time_critical_func(processKnxRxISR)()
 {
+    ISR_MEASURE(openknx.hardware.runtimeKnxRx);
     uart_get_hw(KNX_DMA_UART)->icr = UART_UARTICR_RTIC_BITS | UART_UARTICR_RXIC_BITS;
     #if MASK_VERSION == 0x07B0
     knx.bau().getDataLinkLayer()->processRxISR();
@@ -86,28 +87,44 @@ namespace OpenKNX
         pinMode(PROG_BUTTON_PIN, INPUT_PULLUP);
         attachInterrupt(
             digitalPinToInterrupt(PROG_BUTTON_PIN),
-            []() -> void { openknx.progButton.change(!digitalRead(PROG_BUTTON_PIN)); }, CHANGE);
+            []() -> void {
+                ISR_MEASURE(openknx.hardware.runtimeButtons);
+                openknx.progButton.change(!digitalRead(PROG_BUTTON_PIN));
+            },
+            CHANGE);
 #endif
 
 #ifdef FUNC1_BUTTON_PIN
         pinMode(FUNC1_BUTTON_PIN, INPUT_PULLUP);
         attachInterrupt(
             digitalPinToInterrupt(FUNC1_BUTTON_PIN),
-            []() -> void { openknx.func1Button.change(!digitalRead(FUNC1_BUTTON_PIN)); }, CHANGE);
+            []() -> void {
+                ISR_MEASURE(openknx.hardware.runtimeButtons);
+                openknx.func1Button.change(!digitalRead(FUNC1_BUTTON_PIN));
+            },
+            CHANGE);
 #endif
 
 #ifdef FUNC2_BUTTON_PIN
         pinMode(FUNC2_BUTTON_PIN, INPUT_PULLUP);
         attachInterrupt(
             digitalPinToInterrupt(FUNC2_BUTTON_PIN),
-            []() -> void { openknx.func2Button.change(!digitalRead(FUNC2_BUTTON_PIN)); }, CHANGE);
+            []() -> void {
+                ISR_MEASURE(openknx.hardware.runtimeButtons);
+                openknx.func2Button.change(!digitalRead(FUNC2_BUTTON_PIN));
+            },
+            CHANGE);
 #endif
 
 #ifdef FUNC3_BUTTON_PIN
         pinMode(FUNC3_BUTTON_PIN, INPUT_PULLUP);
         attachInterrupt(
             digitalPinToInterrupt(FUNC3_BUTTON_PIN),
-            []() -> void { openknx.func3Button.change(!digitalRead(FUNC3_BUTTON_PIN)); }, CHANGE);
+            []() -> void {
+                ISR_MEASURE(openknx.hardware.runtimeButtons);
+                openknx.func3Button.change(!digitalRead(FUNC3_BUTTON_PIN));
+            },
+            CHANGE);
 #endif
     }
 
@@ -191,6 +208,7 @@ namespace OpenKNX
     #endif
 #endif
         logIndentDown();
+        openknx.logger.flush();
 
         while (true)
         {
@@ -1,5 +1,6 @@
 #pragma once
 #include "OpenKNX/Button.h"
+#include "OpenKNX/Stat/IsrStat.h"
 #ifdef OPENKNX_SERIALLED_ENABLE
     #include "OpenKNX/Led/Serial.h"
 #else
@@ -20,6 +21,7 @@
 #define FATAL_SENS_UNKNOWN 5            // unknown or unsupported sensor
 #define FATAL_SCHEDULE_MAX_CALLBACKS 6  // Too many callbacks in scheduler
 #define FATAL_NETWORK 7                 // Network error
+#define FATAL_MODULES 8                 // Too many modules or duplicate module id
 #define FATAL_INIT_FILESYSTEM 10        // LittleFS.begin() failed
 #define FATAL_SYSTEM 20                 // Systemerror (e.g. buffer overrun)
 
@@ -37,6 +39,11 @@ namespace OpenKNX
         uint8_t features = 0;
 
       public:
+#ifdef OPENKNX_RUNTIME_STAT
+        Stat::IsrStat runtimeKnxRx;
+        Stat::IsrStat runtimeButtons;
+#endif
+
         // Initialize or HW detection
         void init();
         // Fatal Error
@@ -1,7 +1,7 @@
 #include "Helper.h"
 #include "OpenKNX/Facade.h"
 
-#ifndef ARDUINO_ARCH_ESP32
+#if !defined(ARDUINO_ARCH_ESP32) && !defined(OPENKNX_NATIVE)
 
     /*
      * Free Memory
@@ -13,7 +13,7 @@ extern "C" char *sbrk(int incr);
 extern char *__brkval;
     #endif // __arm__
 
-#endif // !ARDUINO_ARCH_ESP32
+#endif // !ARDUINO_ARCH_ESP32 && !OPENKNX_NATIVE
 
 int freeMemory()
 {
@@ -21,6 +21,9 @@ int freeMemory()
     return ESP.getFreeHeap();
 #elif defined(ARDUINO_ARCH_RP2040)
     return rp2040.getFreeHeap();
+#elif defined(OPENKNX_NATIVE)
+    // no meaningful heap limit on the host
+    return 0x7FFFFFFF;
 #else
     char top;
     #ifdef __arm__
@@ -53,6 +56,71 @@ uint32_t uptime(bool result)
     return ((uint64_t)uptimeRolloverCount << 32 | uptimeCurrentMillis) / 1000UL;
 }
 
+/*
+ * CRC-32
+ * Table driven (slicing-by-4): one table lookup per byte, but 4 bytes per step.
+ * The table is generated on first use (4 KiB, on SAMD only one slice with 1 KiB).
+ */
+#ifdef ARDUINO_ARCH_SAMD
+    #define CRC32_SLICES 1
+#else
+    #define CRC32_SLICES 4
+#endif
+
+static uint32_t crc32Table[CRC32_SLICES][256];
+
+static void crc32Init()
+{
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t crc = i;
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        crc32Table[0][i] = crc;
+    }
+
+    for (uint8_t slice = 1; slice < CRC32_SLICES; slice++)
+        for (uint32_t i = 0; i < 256; i++)
+            crc32Table[slice][i] = (crc32Table[slice - 1][i] >> 8) ^ crc32Table[0][crc32Table[slice - 1][i] & 0xFF];
+}
+
+uint32_t calcCrc32(uint32_t crc, const uint8_t *data, size_t size)
+{
+    if (crc32Table[0][1] == 0)
+        crc32Init();
+
+    crc = ~crc;
+
+#if CRC32_SLICES == 4
+    // bytewise until aligned
+    while (size > 0 && ((uintptr_t)data & 3))
+    {
+        crc = (crc >> 8) ^ crc32Table[0][(crc ^ *data++) & 0xFF];
+        size--;
+    }
+
+    // wordwise (little endian)
+    while (size >= 4)
+    {
+        crc ^= *(const uint32_t *)data;
+        crc = crc32Table[3][crc & 0xFF] ^
+              crc32Table[2][(crc >> 8) & 0xFF] ^
+              crc32Table[1][(crc >> 16) & 0xFF] ^
+              crc32Table[0][crc >> 24];
+        data += 4;
+        size -= 4;
+    }
+#endif
+
+    while (size > 0)
+    {
+        crc = (crc >> 8) ^ crc32Table[0][(crc ^ *data++) & 0xFF];
+        size--;
+    }
+
+    return ~crc;
+}
+
 /*
  * Nuker
  */
@@ -25,6 +25,12 @@ uint32_t uptime(bool result = true);
  */
 int freeMemory();
 
+/*
+ * CRC-32 (IEEE 802.3, as zlib)
+ * crc is the result of the previous call (0 to start), so the checksum can be calculated in parts
+ */
+uint32_t calcCrc32(uint32_t crc, const uint8_t *data, size_t size);
+
 /*
  * Nuker
  */
@@ -105,6 +105,7 @@ namespace OpenKNX
                 pdTRUE,             // Auto-Reload (Wiederholung nach Ablauf)
                 (void *)0,          // Timer-ID (kann für Identifikation verwendet werden)
                 [](TimerHandle_t timer) {
+                    ISR_MEASURE(openknx.ledManager.runtime);
                     openknx.progLed.loop();
     #ifdef INFO2_LED_PIN
                     openknx.info2Led.loop();
@@ -1,6 +1,7 @@
 #pragma once
 #ifdef ARDUINO_ARCH_ESP32
     #include "OpenKNX/Led/Base.h"
+    #include "OpenKNX/Stat/IsrStat.h"
     #include <driver/rmt.h>
 
 namespace OpenKNX
@@ -21,6 +22,10 @@ namespace OpenKNX
             void fillRmt();
 
           public:
+    #ifdef OPENKNX_RUNTIME_STAT
+            Stat::IsrStat runtime;
+    #endif
+
             void init(uint8_t ledPin, uint8_t rmtChannel, uint8_t ledCount);
             void setLED(uint8_t ledAdr, uint8_t r, uint8_t g, uint8_t b);
             void writeLeds(); // send the color data to the LEDs
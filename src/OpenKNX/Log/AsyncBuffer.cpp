@@ -0,0 +1,150 @@
+#include "OpenKNX/Log/Logger.h"
+#ifdef OPENKNX_LOGGER_ASYNC
+    #include "OpenKNX/Facade.h"
+
+    #define ASYNC_MASK (OPENKNX_LOGGER_ASYNC_BUFFER - 1)
+
+static_assert((OPENKNX_LOGGER_ASYNC_BUFFER & ASYNC_MASK) == 0, "OPENKNX_LOGGER_ASYNC_BUFFER must be a power of 2");
+static_assert(OPENKNX_LOGGER_ASYNC_BUFFER <= 0x8000, "OPENKNX_LOGGER_ASYNC_BUFFER must not exceed 32768");
+
+namespace OpenKNX
+{
+    namespace Log
+    {
+        void AsyncBuffer::open()
+        {
+            Ring& ring = ASYNC_BY_CORE(_ring);
+            if (ring.depth++ == 0)
+                ring.lineLength = 0;
+        }
+
+        /*
+         * Ring format: LEN[2] LINE[LEN]
+         */
+        void AsyncBuffer::commit()
+        {
+            Ring& ring = ASYNC_BY_CORE(_ring);
+
+            // nested line (interrupt)
+            if (ring.depth > 1)
+            {
+                ring.dropped++;
+                ring.depth--;
+                return;
+            }
+
+            const uint16_t size = ring.lineLength + 2;
+            const uint16_t head = ring.head;
+            if ((uint16_t)(OPENKNX_LOGGER_ASYNC_BUFFER - (uint16_t)(head - ring.tail)) < size)
+            {
+                ring.dropped++;
+            }
+            else
+            {
+                ring.data[head & ASYNC_MASK] = ring.lineLength & 0xFF;
+                ring.data[(head + 1) & ASYNC_MASK] = ring.lineLength >> 8;
+                for (uint16_t i = 0; i < ring.lineLength; i++)
+                    ring.data[(head + 2 + i) & ASYNC_MASK] = ring.line[i];
+
+                // publish line after data is complete
+                __sync_synchronize();
+                ring.head = head + size;
+            }
+
+            ring.depth = 0;
+        }
+
+        bool AsyncBuffer::lineOpen()
+        {
+            return ASYNC_BY_CORE(_ring).depth > 0;
+        }
+
+        size_t AsyncBuffer::write(uint8_t byte)
+        {
+            return write(&byte, 1);
+        }
+
+        size_t AsyncBuffer::write(const uint8_t* buffer, size_t size)
+        {
+            Ring& ring = ASYNC_BY_CORE(_ring);
+
+            // only the outer line is recorded
+            if (ring.depth != 1) return size;
+
+            const size_t length = MIN(size, (size_t)(OPENKNX_LOGGER_ASYNC_LINE - ring.lineLength));
+            memcpy(ring.line + ring.lineLength, buffer, length);
+            ring.lineLength += length;
+            return size;
+        }
+
+        int AsyncBuffer::format(const char* message, va_list& values)
+        {
+            Ring& ring = ASYNC_BY_CORE(_ring);
+
+            // only the outer line is recorded
+            if (ring.depth != 1) return 0;
+
+            const uint16_t space = MIN((uint16_t)OPENKNX_MAX_LOG_MESSAGE_LENGTH, (uint16_t)(OPENKNX_LOGGER_ASYNC_LINE - ring.lineLength));
+            if (space == 0) return 0;
+
+            const int length = vsnprintf(ring.line + ring.lineLength, space, message, values);
+            if (length > 0)
+                ring.lineLength += MIN((uint16_t)length, (uint16_t)(space - 1));
+            return length;
+        }
+
+        uint32_t AsyncBuffer::drainRing(Print& device, Ring& ring, uint32_t budget)
+        {
+            uint32_t written = 0;
+            uint16_t tail = ring.tail;
+            while (written < budget && tail != ring.head)
+            {
+                __sync_synchronize();
+                const uint16_t length = ring.data[tail & ASYNC_MASK] | (ring.data[(tail + 1) & ASYNC_MASK] << 8);
+                const uint16_t start = (tail + 2) & ASYNC_MASK;
+                const uint16_t first = MIN(length, (uint16_t)(OPENKNX_LOGGER_ASYNC_BUFFER - start));
+                device.write(ring.data + start, first);
+                if (first < length)
+                    device.write(ring.data, length - first);
+
+                tail += length + 2;
+                ring.tail = tail;
+                written += length;
+            }
+            return written;
+        }
+
+        bool AsyncBuffer::drain(Print& device, uint32_t budget)
+        {
+            uint32_t written = 0;
+            bool empty = true;
+            for (uint8_t i = 0; i < OPENKNX_LOGGER_ASYNC_CORES; i++)
+            {
+                if (written < budget)
+                    written += drainRing(device, _ring[i], budget - written);
+                empty = empty && _ring[i].tail == _ring[i].head;
+            }
+
+            const uint32_t current = dropped();
+            if (empty && current != _reportedDropped)
+            {
+                device.print("\33[2K\r");
+                device.print("Logger: ");
+                device.print((unsigned long)(current - _reportedDropped));
+                device.println(" log lines dropped");
+                _reportedDropped = current;
+            }
+
+            return empty;
+        }
+
+        uint32_t AsyncBuffer::dropped()
+        {
+            uint32_t dropped = 0;
+            for (uint8_t i = 0; i < OPENKNX_LOGGER_ASYNC_CORES; i++)
+                dropped += _ring[i].dropped;
+            return dropped;
+        }
+    } // namespace Log
+} // namespace OpenKNX
+#endif
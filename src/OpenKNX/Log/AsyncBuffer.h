@@ -0,0 +1,103 @@
+#pragma once
+#ifdef OPENKNX_LOGGER_ASYNC
+    #include "Arduino.h"
+
+    // Size of the ring buffer per core (power of 2)
+    #ifndef OPENKNX_LOGGER_ASYNC_BUFFER
+        #define OPENKNX_LOGGER_ASYNC_BUFFER 4096
+    #endif
+
+    // Max bytes written to the logger device per loop
+    #ifndef OPENKNX_LOGGER_ASYNC_DRAIN
+        #define OPENKNX_LOGGER_ASYNC_DRAIN 256
+    #endif
+
+    // Max length of one log line incl. timestamp, prefix, indent and color codes
+    #define OPENKNX_LOGGER_ASYNC_LINE (OPENKNX_MAX_LOG_MESSAGE_LENGTH + OPENKNX_MAX_LOG_PREFIX_LENGTH + 64)
+
+    // One ring buffer per core
+    #if defined(ARDUINO_ARCH_RP2040)
+        #define OPENKNX_LOGGER_ASYNC_CORES 2
+        #define ASYNC_BY_CORE(X) X[rp2040.cpuid()]
+    #elif defined(OPENKNX_DUALCORE) && defined(ARDUINO_ARCH_ESP32)
+        #define OPENKNX_LOGGER_ASYNC_CORES 2
+        #define ASYNC_BY_CORE(X) X[xPortGetCoreID() ? 1 : 0]
+    #elif defined(OPENKNX_DUALCORE) && defined(OPENKNX_NATIVE)
+        // loop1() runs in a thread
+        #define OPENKNX_LOGGER_ASYNC_CORES 2
+        #define ASYNC_BY_CORE(X) X[OpenKNX::Native::core]
+    #else
+        #define OPENKNX_LOGGER_ASYNC_CORES 1
+        #define ASYNC_BY_CORE(X) X[0]
+    #endif
+
+namespace OpenKNX
+{
+    namespace Log
+    {
+        /*
+         * Output buffer of the asynchronous logging mode.
+         *
+         * A log line is built in a line buffer of the current core and committed as a whole into the ring
+         * buffer of this core. There is exactly one producer (the core) and one consumer (drain) per ring, so no
+         * lock is needed. A log line started while another line of the same core is in progress (e.g. from an
+         * interrupt) and lines not fitting into the ring are dropped and counted.
+         */
+        class AsyncBuffer : public Print
+        {
+          private:
+            struct Ring
+            {
+                uint8_t data[OPENKNX_LOGGER_ASYNC_BUFFER];
+                volatile uint16_t head = 0; // written by producer
+                volatile uint16_t tail = 0; // written by drain
+                char line[OPENKNX_LOGGER_ASYNC_LINE];
+                uint16_t lineLength = 0;
+                volatile uint8_t depth = 0;
+                volatile uint32_t dropped = 0;
+            };
+            Ring _ring[OPENKNX_LOGGER_ASYNC_CORES];
+            uint32_t _reportedDropped = 0;
+
+            uint32_t drainRing(Print& device, Ring& ring, uint32_t budget);
+
+          public:
+            /*
+             * Start a new line on the current core
+             */
+            void open();
+
+            /*
+             * Finish the line of the current core and move it into the ring buffer.
+             * A nested line is dropped, the outer line stays open until its own commit.
+             */
+            void commit();
+
+            /*
+             * A line of the current core is open (including nested lines)
+             */
+            bool lineOpen();
+
+            size_t write(uint8_t byte) override;
+            size_t write(const uint8_t* buffer, size_t size) override;
+
+            /*
+             * Format directly into the line of the current core
+             * @return length of the formatted message (like vsnprintf), 0 for a nested line
+             */
+            int format(const char* message, va_list& values);
+
+            /*
+             * Write complete lines to the device until budget bytes are written
+             * @return true if all rings are empty
+             */
+            bool drain(Print& device, uint32_t budget);
+
+            /*
+             * Number of dropped lines (all cores)
+             */
+            uint32_t dropped();
+        };
+    } // namespace Log
+} // namespace OpenKNX
+#endif
@@ -5,7 +5,7 @@
     #include "SEGGER_RTT.h"
 #endif
 
-#if defined(OPENKNX_TRACE1) || defined(OPENKNX_TRACE2) || defined(OPENKNX_TRACE3) || defined(OPENKNX_TRACE4) || defined(OPENKNX_TRACE5)
+#ifdef OPENKNX_LOG_TRACE_ENABLED
     #include <Regexp.h>
 #endif
 
@@ -20,6 +20,14 @@ namespace OpenKNX
             recursive_mutex_init(&_mutex);
 #endif
 
+#ifdef OPENKNX_LOG_TRACE_ENABLED
+            traceFilter(0, TRACE_STRINGIFY(OPENKNX_TRACE1));
+            traceFilter(1, TRACE_STRINGIFY(OPENKNX_TRACE2));
+            traceFilter(2, TRACE_STRINGIFY(OPENKNX_TRACE3));
+            traceFilter(3, TRACE_STRINGIFY(OPENKNX_TRACE4));
+            traceFilter(4, TRACE_STRINGIFY(OPENKNX_TRACE5));
+#endif
+
 #ifdef OPENKNX_LOGGER_DEVICE
             OPENKNX_LOGGER_DEVICE.begin(115200);
 #endif
@@ -68,9 +76,64 @@ namespace OpenKNX
             return std::string(buffer);
         }
 
-        void Logger::beforeLog()
+        Print& Logger::output()
         {
+#ifdef OPENKNX_LOGGER_ASYNC
+            if (_async.lineOpen())
+                return _async;
+#endif
+            return OPENKNX_LOGGER_DEVICE;
+        }
+
+        void Logger::loop()
+        {
+#ifdef OPENKNX_LOGGER_ASYNC
+            // switch to async mode with the first loop
+            _asyncActive = true;
             begin();
+            _async.drain(OPENKNX_LOGGER_DEVICE, OPENKNX_LOGGER_ASYNC_DRAIN);
+            end();
+#endif
+        }
+
+        void Logger::flush()
+        {
+#ifdef OPENKNX_LOGGER_ASYNC
+            begin();
+            while (!_async.drain(OPENKNX_LOGGER_DEVICE, OPENKNX_LOGGER_ASYNC_BUFFER))
+                ;
+            end();
+#endif
+        }
+
+        void Logger::beginLine()
+        {
+#ifdef OPENKNX_LOGGER_ASYNC
+            if (_asyncActive)
+            {
+                _async.open();
+                return;
+            }
+#endif
+            begin();
+        }
+
+        void Logger::endLine()
+        {
+#ifdef OPENKNX_LOGGER_ASYNC
+            // the line of the current core stays async until the outer line is committed
+            if (_async.lineOpen())
+            {
+                _async.commit();
+                return;
+            }
+#endif
+            end();
+        }
+
+        void Logger::beforeLog()
+        {
+            beginLine();
             clearPreviouseLine();
             if (isColorSet())
                 printColorCode();
@@ -82,9 +145,9 @@ namespace OpenKNX
         {
             if (isColorSet())
                 printColorCode(0);
-            OPENKNX_LOGGER_DEVICE.println();
+            output().println();
             printPrompt();
-            end();
+            endLine();
         }
 
         void Logger::log(const std::string& message)
@@ -208,6 +271,11 @@ namespace OpenKNX
 
         void Logger::logMacroWrapper(uint8_t logColor, const char* prefix, const char* message, va_list& values)
         {
+#ifdef OPENKNX_LOGGER_BINARY
+            if (logBinary(logColor, prefix, message, values))
+                return;
+#endif
+
             color(logColor);
             const char* found = strchr(message, '%');
             if (found != NULL)
@@ -234,6 +302,154 @@ namespace OpenKNX
             color(0);
         }
 
+#ifdef OPENKNX_LOGGER_BINARY
+        /*
+         * Record: RS[1] LEN[1] FORMAT[4] MILLIS[4] COLOR[1] INDENT[1] PLEN[1] PREFIX[PLEN] ARGS
+         * FORMAT is the address of the format string in flash, resolved by log_decode.py from the firmware.elf.
+         * ARGS are stored in order of the format: integers with 4 bytes (8 bytes for ll/j), floats as double with
+         * 8 bytes and strings as LEN[1] DATA[LEN]. INDENT contains the core in bit 7.
+         */
+        bool Logger::logBinary(uint8_t logColor, const char* prefix, const char* message, va_list& values)
+        {
+            // format must be constant for decoding
+            if (!OPENKNX_LOGGER_BINARY_CONST(message))
+                return false;
+
+            uint8_t record[OPENKNX_LOGGER_BINARY_RECORD];
+            uint16_t size = 2;
+            auto put = [&](const void* data, uint16_t length) -> bool {
+                if (size + length > OPENKNX_LOGGER_BINARY_RECORD) return false;
+                memcpy(record + size, data, length);
+                size += length;
+                return true;
+            };
+
+            const uint32_t format = (uint32_t)(uintptr_t)message;
+            const uint32_t time = millis();
+            uint8_t indent = getIndent();
+    #if defined(OPENKNX_DUALCORE) && defined(ARDUINO_ARCH_RP2040)
+            indent |= rp2040.cpuid() << 7;
+    #elif defined(OPENKNX_DUALCORE) && defined(ARDUINO_ARCH_ESP32)
+            indent |= (xPortGetCoreID() ? 1 : 0) << 7;
+    #endif
+            const uint8_t prefixLength = MIN(strlen(prefix), OPENKNX_MAX_LOG_PREFIX_LENGTH);
+            put(&format, 4);
+            put(&time, 4);
+            put(&logColor, 1);
+            put(&indent, 1);
+            put(&prefixLength, 1);
+            put(prefix, prefixLength);
+
+            va_list args;
+            va_copy(args, values);
+            bool success = true;
+            for (const char* current = message; success && *current; current++)
+            {
+                if (*current != '%') continue;
+                current++;
+                if (*current == '%') continue;
+
+                // flags
+                while (*current && strchr("-+ #0", *current)) current++;
+
+                // width and precision
+                for (uint8_t part = 0; part < 2; part++)
+                {
+                    if (part == 1 && *current != '.') break;
+                    if (part == 1) current++;
+                    if (*current == '*')
+                    {
+                        const int32_t value = va_arg(args, int);
+                        success = put(&value, 4);
+                        current++;
+                    }
+                    while (*current >= '0' && *current <= '9') current++;
+                }
+
+                // length
+                uint8_t length = 0;
+                while (*current && strchr("hlLjzt", *current))
+                {
+                    if (*current == 'l') length++;
+                    if (*current == 'j') length = 2;
+                    if (*current == 'L') length = 3;
+                    current++;
+                }
+
+                switch (*current)
+                {
+                    case 'd':
+                    case 'i':
+                    case 'u':
+                    case 'x':
+                    case 'X':
+                    case 'o':
+                    case 'c':
+                        if (length >= 2)
+                        {
+                            const uint64_t value = va_arg(args, long long);
+                            success = success && put(&value, 8);
+                        }
+                        else
+                        {
+                            const uint32_t value = length ? va_arg(args, long) : va_arg(args, int);
+                            success = success && put(&value, 4);
+                        }
+                        break;
+                    case 'f':
+                    case 'F':
+                    case 'e':
+                    case 'E':
+                    case 'g':
+                    case 'G':
+                    case 'a':
+                    case 'A':
+                        if (length == 3)
+                        {
+                            success = false;
+                        }
+                        else
+                        {
+                            const double value = va_arg(args, double);
+                            success = success && put(&value, 8);
+                        }
+                        break;
+                    case 's':
+                    {
+                        const char* value = va_arg(args, const char*);
+                        // like printf
+                        if (value == nullptr)
+                            value = "(null)";
+                        const uint8_t valueLength = MIN(strlen(value), 0xFF);
+                        success = success && put(&valueLength, 1) && put(value, valueLength);
+                        break;
+                    }
+                    case 'p':
+                    {
+                        const uint32_t value = (uint32_t)(uintptr_t)va_arg(args, void*);
+                        success = success && put(&value, 4);
+                        break;
+                    }
+                    default:
+                        // unsupported (e.g. %n) or incomplete
+                        success = false;
+                }
+            }
+            va_end(args);
+
+            // fallback to text
+            if (!success)
+                return false;
+
+            record[0] = OPENKNX_LOGGER_BINARY_RS;
+            record[1] = size - 2;
+            beginLine();
+            output().write(record, size);
+            endLine();
+            return true;
+        }
+#endif
+
         bool Logger::isColorSet()
         {
             return STATE_BY_CORE(_color) != 0;
@@ -241,9 +457,9 @@ namespace OpenKNX
 
         void Logger::printColorCode(uint8_t color)
         {
-            OPENKNX_LOGGER_DEVICE.print("\x1B[");
-            OPENKNX_LOGGER_DEVICE.print((int)color);
-            OPENKNX_LOGGER_DEVICE.print("m");
+            output().print("\x1B[");
+            output().print((int)color);
+            output().print("m");
         }
 
         void Logger::printColorCode()
@@ -256,17 +472,17 @@ namespace OpenKNX
             for (size_t i = 0; i < size; i++)
             {
                 if (data[i] < 0x10)
-                    OPENKNX_LOGGER_DEVICE.print("0");
+                    output().print("0");
 
-                OPENKNX_LOGGER_DEVICE.print(data[i], HEX);
-                OPENKNX_LOGGER_DEVICE.print(" ");
+                output().print(data[i], HEX);
+                output().print(" ");
             }
         }
 
         void Logger::clearPreviouseLine()
         {
 #ifndef OPENKNX_RTT
-            OPENKNX_LOGGER_DEVICE.print("\33[2K\r");
+            output().print("\33[2K\r");
 #endif
         }
 
@@ -274,8 +490,8 @@ namespace OpenKNX
         {
 #ifndef OPENKNX_RTT
             clearPreviouseLine();
-            OPENKNX_LOGGER_DEVICE.print("$ ");
-            OPENKNX_LOGGER_DEVICE.print(openknx.console.prompt);
+            output().print("$ ");
+            output().print(openknx.console.prompt);
 #endif
         }
 
@@ -286,15 +502,15 @@ namespace OpenKNX
             {
                 if (i < prefixLen)
                 {
-                    OPENKNX_LOGGER_DEVICE.print(prefix[i]);
+                    output().print(prefix[i]);
                 }
                 else if (i == prefixLen && prefixLen > 0)
                 {
-                    OPENKNX_LOGGER_DEVICE.print(":");
+                    output().print(":");
                 }
                 else
                 {
-                    OPENKNX_LOGGER_DEVICE.print(" ");
+                    output().print(" ");
                 }
             }
         }
@@ -305,9 +521,9 @@ namespace OpenKNX
             if (openknx.usesDualCore())
             {
     #if defined(ARDUINO_ARCH_RP2040)
-                OPENKNX_LOGGER_DEVICE.print(rp2040.cpuid() ? "_1> " : "0_> ");
+                output().print(rp2040.cpuid() ? "_1> " : "0_> ");
     #elif defined(ARDUINO_ARCH_ESP32)
-                OPENKNX_LOGGER_DEVICE.print(xPortGetCoreID() ? "_1> " : "0_> ");
+                output().print(xPortGetCoreID() ? "_1> " : "0_> ");
     #endif
             }
 #endif
@@ -315,7 +531,7 @@ namespace OpenKNX
 
         void Logger::printMessage(const char* message)
         {
-            OPENKNX_LOGGER_DEVICE.print(message);
+            output().print(message);
         }
 
         void Logger::printMessage(const char* message, va_list& values)
@@ -323,51 +539,169 @@ namespace OpenKNX
             const char* found = strchr(message, '%');
             if (found == NULL)
             {
-                OPENKNX_LOGGER_DEVICE.print(message);
+                output().print(message);
                 return;
             }
 
-            memset(_buffer, 0, OPENKNX_MAX_LOG_MESSAGE_LENGTH);
-            uint16_t len = vsnprintf(_buffer, OPENKNX_MAX_LOG_MESSAGE_LENGTH, message, values);
-            OPENKNX_LOGGER_DEVICE.print(_buffer);
+            int len;
+#ifdef OPENKNX_LOGGER_ASYNC
+            // _buffer is protected by the lock only, so async lines are formatted into the line of the core
+            if (_async.lineOpen())
+            {
+                len = _async.format(message, values);
+            }
+            else
+#endif
+            {
+                memset(_buffer, 0, OPENKNX_MAX_LOG_MESSAGE_LENGTH);
+                len = vsnprintf(_buffer, OPENKNX_MAX_LOG_MESSAGE_LENGTH, message, values);
+                output().print(_buffer);
+            }
             if (len >= OPENKNX_MAX_LOG_MESSAGE_LENGTH)
                 openknx.hardware.fatalError(FATAL_SYSTEM, "BufferOverflow: increase OPENKNX_MAX_LOG_MESSAGE_LENGTH");
         }
 
-#if defined(OPENKNX_TRACE1) || defined(OPENKNX_TRACE2) || defined(OPENKNX_TRACE3) || defined(OPENKNX_TRACE4) || defined(OPENKNX_TRACE5)
+#ifdef OPENKNX_LOG_TRACE_ENABLED
         bool Logger::checkTrace(const std::string& prefix)
+        {
+            return checkTrace(prefix.c_str());
+        }
+
+        bool Logger::checkTrace(const char* prefix)
+        {
+            // FNV-1a
+            uint32_t hash = 2166136261;
+            const char* current = prefix;
+            for (; *current; current++)
+                hash = (hash ^ (uint8_t)*current) * 16777619;
+            if (hash == 0) hash = 1;
+
+            // longer prefixes can not be verified and are not cached
+            if (current - prefix > OPENKNX_MAX_LOG_PREFIX_LENGTH)
+                return matchTrace(prefix);
+
+            TraceCacheEntry& entry = _traceCache[hash % OPENKNX_TRACE_CACHE];
+            if (entry.hash != hash || strcmp(entry.prefix, prefix))
+            {
+                entry.trace = matchTrace(prefix);
+                entry.hash = hash;
+                strcpy(entry.prefix, prefix);
+            }
+
+            return entry.trace;
+        }
+
+        bool Logger::matchTrace(const char* prefix)
         {
             MatchState ms;
-            ms.Target((char*)prefix.c_str());
-    #ifdef OPENKNX_TRACE1
-            if (strlen(TRACE_STRINGIFY(OPENKNX_TRACE1)) > 0 && ms.MatchCount(TRACE_STRINGIFY(OPENKNX_TRACE1)) > 0)
-                return true;
-    #endif
-    #ifdef OPENKNX_TRACE2
-            if (strlen(TRACE_STRINGIFY(OPENKNX_TRACE2)) > 0 && ms.MatchCount(TRACE_STRINGIFY(OPENKNX_TRACE2)) > 0)
-                return true;
-    #endif
-    #ifdef OPENKNX_TRACE3
-            if (strlen(TRACE_STRINGIFY(OPENKNX_TRACE3)) > 0 && ms.MatchCount(TRACE_STRINGIFY(OPENKNX_TRACE3)) > 0)
-                return true;
-    #endif
-    #ifdef OPENKNX_TRACE4
-            if (strlen(TRACE_STRINGIFY(OPENKNX_TRACE4)) > 0 && ms.MatchCount(TRACE_STRINGIFY(OPENKNX_TRACE4)) > 0)
-                return true;
-    #endif
-    #ifdef OPENKNX_TRACE5
-            if (strlen(TRACE_STRINGIFY(OPENKNX_TRACE5)) > 0 && ms.MatchCount(TRACE_STRINGIFY(OPENKNX_TRACE5)))
-                return true;
-    #endif
+            ms.Target((char*)prefix);
+            for (uint8_t i = 0; i < OPENKNX_TRACE_FILTERS; i++)
+            {
+                if (_traceFilters[i][0] && ms.MatchCount(_traceFilters[i]) > 0)
+                    return true;
+            }
 
             return false;
         }
+
+        void Logger::traceFilter(uint8_t index, const char* filter)
+        {
+            if (index >= OPENKNX_TRACE_FILTERS) return;
+
+            strncpy(_traceFilters[index], filter, OPENKNX_TRACE_FILTER_LENGTH);
+            _traceFilters[index][OPENKNX_TRACE_FILTER_LENGTH] = 0;
+            memset(_traceCache, 0, sizeof(_traceCache));
+        }
+
+        void Logger::showTraceFilters()
+        {
+            for (uint8_t i = 0; i < OPENKNX_TRACE_FILTERS; i++)
+                logWithPrefixAndValues("Logger", "Trace filter %i: %s", i + 1, _traceFilters[i]);
+        }
 #endif
 
+        bool Logger::checkLevel(uint8_t level, const std::string& prefix)
+        {
+            return checkLevel(level, prefix.c_str());
+        }
+
+        bool Logger::checkLevel(uint8_t level, const char* prefix)
+        {
+            if (_levelRuleCount == 0)
+                return level <= _level;
+
+            // longest matching prefix
+            uint8_t matchLevel = _level;
+            size_t matchLength = 0;
+            for (uint8_t i = 0; i < _levelRuleCount; i++)
+            {
+                const size_t length = strlen(_levelRules[i].prefix);
+                if (length > matchLength && strncmp(prefix, _levelRules[i].prefix, length) == 0)
+                {
+                    matchLevel = _levelRules[i].level;
+                    matchLength = length;
+                }
+            }
+
+            return level <= matchLevel;
+        }
+
+        void Logger::updateMaxLevel()
+        {
+            _maxLevel = _level;
+            for (uint8_t i = 0; i < _levelRuleCount; i++)
+                _maxLevel = MAX(_maxLevel, _levelRules[i].level);
+        }
+
+        void Logger::level(uint8_t level)
+        {
+            _level = level;
+            updateMaxLevel();
+        }
+
+        uint8_t Logger::level()
+        {
+            return _level;
+        }
+
+        bool Logger::level(const char* prefix, uint8_t level)
+        {
+            uint8_t i = 0;
+            while (i < _levelRuleCount && strncmp(_levelRules[i].prefix, prefix, OPENKNX_MAX_LOG_PREFIX_LENGTH) != 0) i++;
+
+            if (level == 0xFF)
+            {
+                // remove
+                if (i < _levelRuleCount)
+                    _levelRules[i] = _levelRules[--_levelRuleCount];
+            }
+            else
+            {
+                if (i == _levelRuleCount)
+                {
+                    if (_levelRuleCount >= OPENKNX_LOG_LEVEL_RULES) return false;
+                    strncpy(_levelRules[i].prefix, prefix, OPENKNX_MAX_LOG_PREFIX_LENGTH);
+                    _levelRules[i].prefix[OPENKNX_MAX_LOG_PREFIX_LENGTH] = 0;
+                    _levelRuleCount++;
+                }
+                _levelRules[i].level = level;
+            }
+
+            updateMaxLevel();
+            return true;
+        }
+
+        void Logger::showLevels()
+        {
+            logWithPrefixAndValues("Logger", "Level: %i (compiled: %i)", _level, OPENKNX_LOG_LEVEL);
+            for (uint8_t i = 0; i < _levelRuleCount; i++)
+                logWithPrefixAndValues("Logger", "Level %s*: %i", _levelRules[i].prefix, _levelRules[i].level);
+        }
+
         void Logger::printIndent()
         {
             for (size_t i = 0; i < getIndent(); i++)
-                OPENKNX_LOGGER_DEVICE.print("  ");
+                output().print("  ");
         }
 
         void Logger::indentUp()
@@ -416,8 +750,8 @@ namespace OpenKNX
 
         void Logger::printTimestamp()
         {
-            OPENKNX_LOGGER_DEVICE.print(buildUptime().c_str());
-            OPENKNX_LOGGER_DEVICE.print(": ");
+            output().print(buildUptime().c_str());
+            output().print(": ");
         }
 
         std::string Logger::buildUptime()
@@ -22,20 +22,31 @@
     #define OPENKNX_MAX_LOG_MESSAGE_LENGTH 200
 #endif
 
+#include "OpenKNX/Log/AsyncBuffer.h"
+
+#ifdef OPENKNX_LOGGER_BINARY
+    // Record separator in front of each binary log record (not used in text output)
+    #define OPENKNX_LOGGER_BINARY_RS 0x1E
+    // Max size of a binary log record incl. RS and LEN
+    #define OPENKNX_LOGGER_BINARY_RECORD 257
+
+    // Only formats in flash can be resolved from the firmware.elf. All other messages are logged as text.
+    #if defined(OPENKNX_LOGGER_BINARY_CONST)
+    #elif defined(ARDUINO_ARCH_RP2040)
+        #define OPENKNX_LOGGER_BINARY_CONST(P) ((uintptr_t)(P) >= 0x10000000 && (uintptr_t)(P) < 0x11000000)
+    #elif defined(ARDUINO_ARCH_ESP32)
+        #define OPENKNX_LOGGER_BINARY_CONST(P) (((uintptr_t)(P) >= 0x3F400000 && (uintptr_t)(P) < 0x3F800000) || ((uintptr_t)(P) >= 0x3C000000 && (uintptr_t)(P) < 0x3E000000))
+    #elif defined(ARDUINO_ARCH_SAMD)
+        #define OPENKNX_LOGGER_BINARY_CONST(P) ((uintptr_t)(P) < 0x20000000)
+    #else
+        #define OPENKNX_LOGGER_BINARY_CONST(P) false
+    #endif
+#endif
+
 #define logIndentUp() openknx.logger.indentUp()
 #define logIndentDown() openknx.logger.indentDown()
 #define logIndent(X) openknx.logger.indent(X)
 
-#define logError(...) openknx.logger.logMacroWrapper(31, __VA_ARGS__)
-#define logErrorP(...) openknx.logger.logMacroWrapper(31, logPrefix().c_str(), __VA_ARGS__)
-#define logHexError(...) openknx.logger.logHexMacroWrapper(31, __VA_ARGS__)
-#define logHexErrorP(...) openknx.logger.logHexMacroWrapper(31, logPrefix().c_str(), __VA_ARGS__)
-
-#define logInfo(...) openknx.logger.logMacroWrapper(0, __VA_ARGS__)
-#define logInfoP(...) openknx.logger.logMacroWrapper(0, logPrefix().c_str(), __VA_ARGS__)
-#define logHexInfo(...) openknx.logger.logHexMacroWrapper(0, __VA_ARGS__)
-#define logHexInfoP(...) openknx.logger.logHexMacroWrapper(0, logPrefix().c_str(), __VA_ARGS__)
-
 #if defined(OPENKNX_TRACE1) || defined(OPENKNX_TRACE2) || defined(OPENKNX_TRACE3) || defined(OPENKNX_TRACE4) || defined(OPENKNX_TRACE5)
 
     #ifndef OPENKNX_TRACE1
@@ -59,18 +70,99 @@
     // Force Debug Mode during Trace
     #undef OPENKNX_DEBUG
     #define OPENKNX_DEBUG
-    #define logTrace(prefix, ...)              \
-        if (openknx.logger.checkTrace(prefix)) \
-        openknx.logger.logMacroWrapper(90, prefix, __VA_ARGS__)
-    #define logTraceP(...)                                  \
-        if (openknx.logger.checkTrace(logPrefix().c_str())) \
-        openknx.logger.logMacroWrapper(90, logPrefix().c_str(), __VA_ARGS__)
-    #define logHexTrace(prefix, ...)           \
-        if (openknx.logger.checkTrace(prefix)) \
-        openknx.logger.logHexMacroWrapper(90, prefix, __VA_ARGS__)
-    #define logHexTraceP(...)                               \
-        if (openknx.logger.checkTrace(logPrefix().c_str())) \
-        openknx.logger.logHexMacroWrapper(90, logPrefix().c_str(), __VA_ARGS__)
+    #define OPENKNX_LOG_TRACE_ENABLED
+
+    // Number of cached trace decisions (by prefix)
+    #ifndef OPENKNX_TRACE_CACHE
+        #define OPENKNX_TRACE_CACHE 32
+    #endif
+    #define OPENKNX_TRACE_FILTERS 5
+    #define OPENKNX_TRACE_FILTER_LENGTH 40
+#endif
+
+#define OPENKNX_LOG_LEVEL_NONE 0
+#define OPENKNX_LOG_LEVEL_ERROR 1
+#define OPENKNX_LOG_LEVEL_INFO 2
+#define OPENKNX_LOG_LEVEL_DEBUG 3
+#define OPENKNX_LOG_LEVEL_TRACE 4
+
+/*
+ * Highest log level compiled in. Log macros of higher levels compile to nothing.
+ * The level can be lowered at runtime globally or by prefix (console: "log level").
+ */
+#ifndef OPENKNX_LOG_LEVEL
+    #if defined(OPENKNX_LOG_TRACE_ENABLED)
+        #define OPENKNX_LOG_LEVEL OPENKNX_LOG_LEVEL_TRACE
+    #elif defined(OPENKNX_DEBUG)
+        #define OPENKNX_LOG_LEVEL OPENKNX_LOG_LEVEL_DEBUG
+    #else
+        #define OPENKNX_LOG_LEVEL OPENKNX_LOG_LEVEL_INFO
+    #endif
+#endif
+
+// Number of log levels by prefix
+#ifndef OPENKNX_LOG_LEVEL_RULES
+    #define OPENKNX_LOG_LEVEL_RULES 8
+#endif
+
+/*
+ * The level is checked before the prefix is built. The prefix is only needed for the check,
+ * if levels by prefix are configured.
+ */
+#define OPENKNX_LOG_NO_FILTER(prefix) true
+#define OPENKNX_LOG_MACRO(level, color, wrapper, filter, prefix, ...)                                                  \
+    do                                                                                                                  \
+    {                                                                                                                   \
+        if (openknx.logger.checkLevel(level))                                                                           \
+        {                                                                                                               \
+            const auto& logMacroPrefix = prefix;                                                                        \
+            if (openknx.logger.checkLevel(level, logMacroPrefix) && filter(logMacroPrefix))                             \
+                openknx.logger.wrapper(color, logMacroPrefix, __VA_ARGS__);                                             \
+        }                                                                                                               \
+    }                                                                                                                   \
+    while (0)
+#define OPENKNX_LOG_MACRO_P(level, color, wrapper, filter, ...)                                                         \
+    do                                                                                                                  \
+    {                                                                                                                   \
+        if (openknx.logger.checkLevel(level))                                                                           \
+        {                                                                                                               \
+            const std::string logMacroPrefix = logPrefix();                                                             \
+            if (openknx.logger.checkLevel(level, logMacroPrefix.c_str()) && filter(logMacroPrefix.c_str()))             \
+                openknx.logger.wrapper(color, logMacroPrefix.c_str(), __VA_ARGS__);                                     \
+        }                                                                                                               \
+    }                                                                                                                   \
+    while (0)
+
+#if OPENKNX_LOG_LEVEL >= OPENKNX_LOG_LEVEL_ERROR
+    #define logError(...) OPENKNX_LOG_MACRO(OPENKNX_LOG_LEVEL_ERROR, 31, logMacroWrapper, OPENKNX_LOG_NO_FILTER, __VA_ARGS__)
+    #define logErrorP(...) OPENKNX_LOG_MACRO_P(OPENKNX_LOG_LEVEL_ERROR, 31, logMacroWrapper, OPENKNX_LOG_NO_FILTER, __VA_ARGS__)
+    #define logHexError(...) OPENKNX_LOG_MACRO(OPENKNX_LOG_LEVEL_ERROR, 31, logHexMacroWrapper, OPENKNX_LOG_NO_FILTER, __VA_ARGS__)
+    #define logHexErrorP(...) OPENKNX_LOG_MACRO_P(OPENKNX_LOG_LEVEL_ERROR, 31, logHexMacroWrapper, OPENKNX_LOG_NO_FILTER, __VA_ARGS__)
+#else
+    #define logError(...)
+    #define logErrorP(...)
+    #define logHexError(...)
+    #define logHexErrorP(...)
+#endif
+
+#if OPENKNX_LOG_LEVEL >= OPENKNX_LOG_LEVEL_INFO
+    #define logInfo(...) OPENKNX_LOG_MACRO(OPENKNX_LOG_LEVEL_INFO, 0, logMacroWrapper, OPENKNX_LOG_NO_FILTER, __VA_ARGS__)
+    #define logInfoP(...) OPENKNX_LOG_MACRO_P(OPENKNX_LOG_LEVEL_INFO, 0, logMacroWrapper, OPENKNX_LOG_NO_FILTER, __VA_ARGS__)
+    #define logHexInfo(...) OPENKNX_LOG_MACRO(OPENKNX_LOG_LEVEL_INFO, 0, logHexMacroWrapper, OPENKNX_LOG_NO_FILTER, __VA_ARGS__)
+    #define logHexInfoP(...) OPENKNX_LOG_MACRO_P(OPENKNX_LOG_LEVEL_INFO, 0, logHexMacroWrapper, OPENKNX_LOG_NO_FILTER, __VA_ARGS__)
+#else
+    #define logInfo(...)
+    #define logInfoP(...)
+    #define logHexInfo(...)
+    #define logHexInfoP(...)
+#endif
+
+#if defined(OPENKNX_LOG_TRACE_ENABLED) && OPENKNX_LOG_LEVEL >= OPENKNX_LOG_LEVEL_TRACE
+    #define OPENKNX_LOG_TRACE_FILTER(prefix) openknx.logger.checkTrace(prefix)
+    #define logTrace(...) OPENKNX_LOG_MACRO(OPENKNX_LOG_LEVEL_TRACE, 90, logMacroWrapper, OPENKNX_LOG_TRACE_FILTER, __VA_ARGS__)
+    #define logTraceP(...) OPENKNX_LOG_MACRO_P(OPENKNX_LOG_LEVEL_TRACE, 90, logMacroWrapper, OPENKNX_LOG_TRACE_FILTER, __VA_ARGS__)
+    #define logHexTrace(...) OPENKNX_LOG_MACRO(OPENKNX_LOG_LEVEL_TRACE, 90, logHexMacroWrapper, OPENKNX_LOG_TRACE_FILTER, __VA_ARGS__)
+    #define logHexTraceP(...) OPENKNX_LOG_MACRO_P(OPENKNX_LOG_LEVEL_TRACE, 90, logHexMacroWrapper, OPENKNX_LOG_TRACE_FILTER, __VA_ARGS__)
 #else
     #define logTrace(...)
     #define logTraceP(...)
@@ -78,11 +170,11 @@
     #define logHexTraceP(...)
 #endif
 
-#ifdef OPENKNX_DEBUG
-    #define logDebug(...) openknx.logger.logMacroWrapper(90, __VA_ARGS__)
-    #define logDebugP(...) openknx.logger.logMacroWrapper(90, logPrefix().c_str(), __VA_ARGS__)
-    #define logHexDebug(...) openknx.logger.logHexMacroWrapper(90, __VA_ARGS__)
-    #define logHexDebugP(...) openknx.logger.logHexMacroWrapper(90, logPrefix().c_str(), __VA_ARGS__)
+#if defined(OPENKNX_DEBUG) && OPENKNX_LOG_LEVEL >= OPENKNX_LOG_LEVEL_DEBUG
+    #define logDebug(...) OPENKNX_LOG_MACRO(OPENKNX_LOG_LEVEL_DEBUG, 90, logMacroWrapper, OPENKNX_LOG_NO_FILTER, __VA_ARGS__)
+    #define logDebugP(...) OPENKNX_LOG_MACRO_P(OPENKNX_LOG_LEVEL_DEBUG, 90, logMacroWrapper, OPENKNX_LOG_NO_FILTER, __VA_ARGS__)
+    #define logHexDebug(...) OPENKNX_LOG_MACRO(OPENKNX_LOG_LEVEL_DEBUG, 90, logHexMacroWrapper, OPENKNX_LOG_NO_FILTER, __VA_ARGS__)
+    #define logHexDebugP(...) OPENKNX_LOG_MACRO_P(OPENKNX_LOG_LEVEL_DEBUG, 90, logHexMacroWrapper, OPENKNX_LOG_NO_FILTER, __VA_ARGS__)
 #else
     #define logDebug(...)
     #define logDebugP(...)
@@ -126,6 +218,35 @@ namespace OpenKNX
 #else
             uint8_t _color = 0;
             uint8_t _indent = 0;
+#endif
+#ifdef OPENKNX_LOGGER_ASYNC
+            AsyncBuffer _async;
+            volatile bool _asyncActive = false;
+#endif
+            Print& output();
+
+            struct LevelRule
+            {
+                char prefix[OPENKNX_MAX_LOG_PREFIX_LENGTH + 1];
+                uint8_t level;
+            };
+            uint8_t _level = OPENKNX_LOG_LEVEL;
+            // max of _level and all rules
+            uint8_t _maxLevel = OPENKNX_LOG_LEVEL;
+            LevelRule _levelRules[OPENKNX_LOG_LEVEL_RULES] = {};
+            uint8_t _levelRuleCount = 0;
+            void updateMaxLevel();
+#ifdef OPENKNX_LOG_TRACE_ENABLED
+            struct TraceCacheEntry
+            {
+                uint32_t hash;
+                bool trace;
+                // verifies a hit, as different prefixes can have the same hash
+                char prefix[OPENKNX_MAX_LOG_PREFIX_LENGTH + 1];
+            };
+            char _traceFilters[OPENKNX_TRACE_FILTERS][OPENKNX_TRACE_FILTER_LENGTH + 1] = {};
+            TraceCacheEntry _traceCache[OPENKNX_TRACE_CACHE] = {};
+            bool matchTrace(const char* prefix);
 #endif
             void printHex(const uint8_t* data, size_t size);
             void printMessage(const char* message, va_list& values);
@@ -136,8 +257,13 @@ namespace OpenKNX
             void logMacroWrapper(uint8_t logColor, const char* prefix, const char* message, va_list& values);
             void printCore();
             bool isColorSet();
+            void beginLine();
+            void endLine();
             void beforeLog();
             void afterLog();
+#ifdef OPENKNX_LOGGER_BINARY
+            bool logBinary(uint8_t logColor, const char* prefix, const char* message, va_list& values);
+#endif
             /*
              * RED             1
              * GREEN           2
@@ -172,6 +298,17 @@ namespace OpenKNX
              */
             void end();
 
+            /*
+             * Write buffered log lines to the logger device within a byte budget (OPENKNX_LOGGER_ASYNC only).
+             * Enables the asynchronous mode with the first call.
+             */
+            void loop();
+
+            /*
+             * Write all buffered log lines to the logger device (OPENKNX_LOGGER_ASYNC only).
+             */
+            void flush();
+
             std::string buildPrefix(const char* prefix, const char* id);
             std::string buildPrefix(const std::string& prefix, const std::string& id);
             std::string buildPrefix(const char* prefix, const int id);
@@ -203,9 +340,45 @@ namespace OpenKNX
             void indentDown();
             void indent(uint8_t indent);
 
-#if defined(OPENKNX_TRACE1) || defined(OPENKNX_TRACE2) || defined(OPENKNX_TRACE3) || defined(OPENKNX_TRACE4) || defined(OPENKNX_TRACE5)
+#ifdef OPENKNX_LOG_TRACE_ENABLED
+            /*
+             * Check whether the prefix matches one of the trace filters. The result is cached by prefix.
+             */
+            bool checkTrace(const char* prefix);
             bool checkTrace(const std::string& prefix);
+
+            /*
+             * Replace a trace filter (Regexp) at runtime. An empty filter is disabled.
+             * @param index 0 - 4 (OPENKNX_TRACE1 - OPENKNX_TRACE5)
+             */
+            void traceFilter(uint8_t index, const char* filter);
+            void showTraceFilters();
 #endif
+
+            /*
+             * Check whether the level is enabled for at least one prefix
+             */
+            inline bool checkLevel(uint8_t level) { return level <= _maxLevel; }
+
+            /*
+             * Check whether the level is enabled for the prefix
+             */
+            bool checkLevel(uint8_t level, const char* prefix);
+            bool checkLevel(uint8_t level, const std::string& prefix);
+
+            /*
+             * Set the log level for all prefixes without own level
+             */
+            void level(uint8_t level);
+            uint8_t level();
+
+            /*
+             * Set the log level for all prefixes starting with prefix. The longest matching prefix wins.
+             * @param level level or 0xFF to remove the level of the prefix
+             * @return false if no more levels by prefix are possible (OPENKNX_LOG_LEVEL_RULES)
+             */
+            bool level(const char* prefix, uint8_t level);
+            void showLevels();
             void printPrompt();
             void clearPreviouseLine();
             void logOpenKnxHeader();
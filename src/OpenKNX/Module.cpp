@@ -3,6 +3,28 @@
 
 namespace OpenKNX
 {
+    uint8_t Module::loopPriority()
+    {
+        return OPENKNX_LOOP_PRIORITY_NORMAL;
+    }
+
+    uint32_t Module::loopInterval()
+    {
+        return 0;
+    }
+
+    uint32_t Module::loopBudget()
+    {
+        return 0;
+    }
+
+#if (MASK_VERSION & 0x0900) != 0x0900 // Coupler do not have GroupObjects
+    void Module::subscribeInputKo(uint16_t first, uint16_t last)
+    {
+        openknx.common.subscribeInputKo(this, first, last);
+    }
+#endif
+
     uint16_t Module::flashSize()
     {
         return 0;
@@ -12,6 +34,11 @@ namespace OpenKNX
 
     void Module::readFlash(const uint8_t *data, const uint16_t size) {}
 
+    bool Module::restoreLazy()
+    {
+        return false;
+    }
+
     void Module::processAfterStartupDelay() {}
 
     void Module::processBeforeRestart() {}
@@ -1,5 +1,8 @@
 #pragma once
 #include "OpenKNX/Base.h"
+#ifdef OPENKNX_RUNTIME_STAT
+    #include "OpenKNX/Stat/RuntimeStat.h"
+#endif
 
 namespace OpenKNX
 {
@@ -9,6 +12,16 @@ namespace OpenKNX
     class Module : public Base
     {
       public:
+#ifdef OPENKNX_RUNTIME_STAT
+        /*
+         * Runtime statistic of loop() (and loop1() on core1), measured by Common
+         */
+        Stat::RuntimeStat runtime;
+    #ifdef OPENKNX_DUALCORE
+        Stat::RuntimeStat runtime1;
+    #endif
+#endif
+
         /*
          * The version of module.
          *
@@ -20,6 +33,38 @@ namespace OpenKNX
          */
         virtual const std::string version() = 0;
 
+        /*
+         * Priority of loop(). If the free loop time is not sufficient for all modules,
+         * modules with higher priority are called first. Modules with equal priority are called
+         * in the order of their lateness.
+         *
+         * @return priority (OPENKNX_LOOP_PRIORITY_LOW, _NORMAL, _HIGH or any value between)
+         */
+        virtual uint8_t loopPriority();
+
+        /*
+         * Minimum interval between two calls of loop(). The module is skipped until the interval is expired.
+         *
+         * @return interval in µs (0 = as often as possible)
+         */
+        virtual uint32_t loopInterval();
+
+        /*
+         * Expected maximum runtime of loop(). Used to decide whether loop() fits in the remaining loop time.
+         *
+         * @return runtime in µs (0 = use the measured runtime)
+         */
+        virtual uint32_t loopBudget();
+
+#if (MASK_VERSION & 0x0900) != 0x0900 // Coupler do not have GroupObjects
+        /*
+         * Deliver only GroupObjects with asap first..last (included) to processInputKo().
+         * Can be called several times in setup() to subscribe multiple ranges.
+         * A module without any subscription receives all GroupObjects.
+         */
+        void subscribeInputKo(uint16_t first, uint16_t last);
+#endif
+
         /*
          * This method must returned the size for reservation space in flash storage.
          * @return size in bytes
@@ -36,10 +81,18 @@ namespace OpenKNX
         /*
          * Called after setup to load data from flash storage.
          * @param data pointer to data of module in flash, but the better way is to use read helper of FlashStorage (openknx.flash.readXXX)
-         * @param size number of saved bytes in flash. if no data is saved, the size is 0 (e.g. for init)
+         * @param size number of saved bytes in flash. if no data is saved, the size is 0 and data is nullptr (e.g. for init)
          */
         virtual void readFlash(const uint8_t *data, const uint16_t size);
 
+        /*
+         * Restore the data of this module on demand instead of directly after setup (faster boot).
+         * readFlash() is called on openknx.flash.restore(this) or in the background after the startup delay,
+         * but always before the data of the module is saved.
+         * @return true to restore lazy
+         */
+        virtual bool restoreLazy();
+
         /*
          * Called after the startup delay time are expired.
          */
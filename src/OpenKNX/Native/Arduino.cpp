@@ -0,0 +1,162 @@
+#ifdef OPENKNX_NATIVE
+    #include <Arduino.h>
+    #include <cstdarg>
+    #include <fcntl.h>
+    #include <unistd.h>
+
+OpenKNX::Native::StdioStream Serial;
+
+/*
+ * GPIO and interrupts are not available on the host.
+ * The functions are weak, so a test or benchmark can replace them to simulate hardware.
+ */
+__attribute__((weak)) void pinMode(uint32_t pin, uint32_t mode) {}
+__attribute__((weak)) void digitalWrite(uint32_t pin, uint32_t value) {}
+__attribute__((weak)) uint32_t digitalRead(uint32_t pin) { return HIGH; }
+__attribute__((weak)) void analogWrite(uint32_t pin, int value) {}
+__attribute__((weak)) int analogRead(uint32_t pin) { return 0; }
+__attribute__((weak)) void attachInterrupt(uint32_t pin, voidFuncPtr callback, uint32_t mode) {}
+__attribute__((weak)) void noInterrupts() {}
+__attribute__((weak)) void interrupts() {}
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t written = 0;
+    while (size--)
+        written += write(*buffer++);
+
+    return written;
+}
+
+size_t Print::print(const char *value)
+{
+    return write((const uint8_t *)value, strlen(value));
+}
+
+size_t Print::print(char value)
+{
+    return write((uint8_t)value);
+}
+
+size_t Print::print(unsigned char value, int base)
+{
+    return printNumber(value, base);
+}
+
+size_t Print::print(int value, int base)
+{
+    return print((long)value, base);
+}
+
+size_t Print::print(unsigned int value, int base)
+{
+    return printNumber(value, base);
+}
+
+size_t Print::print(long value, int base)
+{
+    if (base == DEC && value < 0)
+        return print('-') + printNumber(-value, base);
+
+    return printNumber(value, base);
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+    return printNumber(value, base);
+}
+
+size_t Print::print(double value, int digits)
+{
+    char buffer[32] = {};
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    return print(buffer);
+}
+
+size_t Print::println(const char *value)
+{
+    return print(value) + print("\r\n");
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char buffer[256] = {};
+    va_list values;
+    va_start(values, format);
+    vsnprintf(buffer, sizeof(buffer), format, values);
+    va_end(values);
+    return print(buffer);
+}
+
+size_t Print::printNumber(unsigned long value, int base)
+{
+    char buffer[8 * sizeof(long) + 1] = {};
+    char *current = &buffer[sizeof(buffer) - 1];
+
+    if (base < 2)
+        base = 10;
+
+    do
+    {
+        const unsigned long digit = value % base;
+        value /= base;
+        *--current = digit < 10 ? digit + '0' : digit + 'A' - 10;
+    }
+    while (value);
+
+    return print(current);
+}
+
+namespace OpenKNX
+{
+    namespace Native
+    {
+        thread_local uint8_t core = 0;
+
+        void StdioStream::begin(unsigned long baud)
+        {
+            // console input must not block the loop
+            fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+        }
+
+        int StdioStream::available()
+        {
+            return peek() >= 0 ? 1 : 0;
+        }
+
+        int StdioStream::read()
+        {
+            const int current = peek();
+            _peeked = -1;
+            return current;
+        }
+
+        int StdioStream::peek()
+        {
+            if (_peeked < 0)
+            {
+                uint8_t current = 0;
+                if (::read(STDIN_FILENO, &current, 1) == 1)
+                    _peeked = current;
+            }
+
+            return _peeked;
+        }
+
+        size_t StdioStream::write(uint8_t byte)
+        {
+            return fwrite(&byte, 1, 1, stdout);
+        }
+
+        size_t StdioStream::write(const uint8_t *buffer, size_t size)
+        {
+            return fwrite(buffer, 1, size, stdout);
+        }
+
+        void StdioStream::flush()
+        {
+            fflush(stdout);
+        }
+    } // namespace Native
+} // namespace OpenKNX
+#endif
@@ -0,0 +1,80 @@
+#ifdef OPENKNX_NATIVE
+    #include "OpenKNX/Native/Clock.h"
+    #include <atomic>
+    #include <chrono>
+    #include <thread>
+
+namespace OpenKNX
+{
+    namespace Native
+    {
+        static const std::chrono::steady_clock::time_point _clockStart = std::chrono::steady_clock::now();
+        static std::atomic<bool> _clockFrozen(false);
+        static std::atomic<uint64_t> _clockFrozenTime(0);
+        static std::atomic<int64_t> _clockOffset(0);
+
+        static uint64_t hostTime()
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _clockStart).count();
+        }
+
+        uint64_t Clock::now()
+        {
+            if (_clockFrozen)
+                return _clockFrozenTime;
+
+            return hostTime() + _clockOffset;
+        }
+
+        void Clock::freeze()
+        {
+            _clockFrozenTime = now();
+            _clockFrozen = true;
+        }
+
+        void Clock::release()
+        {
+            _clockOffset = (int64_t)_clockFrozenTime - (int64_t)hostTime();
+            _clockFrozen = false;
+        }
+
+        bool Clock::frozen()
+        {
+            return _clockFrozen;
+        }
+
+        void Clock::advance(uint64_t us)
+        {
+            if (_clockFrozen)
+                _clockFrozenTime += us;
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds(us));
+        }
+
+        void Clock::set(uint64_t us)
+        {
+            _clockFrozenTime = us;
+        }
+    } // namespace Native
+} // namespace OpenKNX
+
+uint32_t millis()
+{
+    return OpenKNX::Native::Clock::now() / 1000;
+}
+
+uint32_t micros()
+{
+    return OpenKNX::Native::Clock::now();
+}
+
+void delay(uint32_t ms)
+{
+    OpenKNX::Native::Clock::advance((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    OpenKNX::Native::Clock::advance(us);
+}
+#endif
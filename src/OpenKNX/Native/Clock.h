@@ -0,0 +1,49 @@
+#pragma once
+#ifdef OPENKNX_NATIVE
+    #include <cstdint>
+
+namespace OpenKNX
+{
+    namespace Native
+    {
+        /*
+         * Time source for millis(), micros() and delay() of the native build.
+         *
+         * By default the clock follows the monotonic host clock.
+         * After freeze() the time only changes by advance() or set(), which allows deterministic
+         * tests and benchmarks of time dependent code (e.g. startup delay, heartbeat, periodic save).
+         * A delay() on a frozen clock advances the clock instead of sleeping.
+         */
+        class Clock
+        {
+          public:
+            /*
+             * Stop following the host clock. The current time is kept.
+             */
+            static void freeze();
+
+            /*
+             * Follow the host clock again, continuing from the current time.
+             */
+            static void release();
+
+            static bool frozen();
+
+            /*
+             * Advance the (frozen) clock
+             */
+            static void advance(uint64_t us);
+
+            /*
+             * Set the (frozen) clock to an absolute time since start
+             */
+            static void set(uint64_t us);
+
+            /*
+             * Time since start in µs
+             */
+            static uint64_t now();
+        };
+    } // namespace Native
+} // namespace OpenKNX
+#endif
@@ -0,0 +1,146 @@
+#pragma once
+/*
+ * Minimal Arduino API for the native (host) build of OGM-Common.
+ * Only the parts used by OGM-Common are provided. Time is based on OpenKNX::Native::Clock.
+ *
+ * This directory must only be added to the include path of the native environment (see platformio.native.ini)!
+ */
+#ifndef OPENKNX_NATIVE
+    #error "The Arduino API shim of OGM-Common may only be used for native builds (-D OPENKNX_NATIVE)"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/types.h>
+
+#ifndef LOW
+    #define LOW 0
+#endif
+#ifndef HIGH
+    #define HIGH 1
+#endif
+#ifndef CHANGE
+    #define CHANGE 2
+#endif
+#ifndef FALLING
+    #define FALLING 3
+#endif
+#ifndef RISING
+    #define RISING 4
+#endif
+#ifndef INPUT
+    #define INPUT 0
+#endif
+#ifndef OUTPUT
+    #define OUTPUT 1
+#endif
+#ifndef INPUT_PULLUP
+    #define INPUT_PULLUP 2
+#endif
+
+#ifndef PI
+    #define PI 3.1415926535897932384626433832795
+#endif
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#ifndef MIN
+    #define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+    #define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+using std::max;
+using std::min;
+
+typedef uint8_t pin_size_t;
+typedef void (*voidFuncPtr)(void);
+
+#define digitalPinToInterrupt(P) (P)
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint32_t pin, uint32_t mode);
+void digitalWrite(uint32_t pin, uint32_t value);
+uint32_t digitalRead(uint32_t pin);
+void analogWrite(uint32_t pin, int value);
+int analogRead(uint32_t pin);
+void attachInterrupt(uint32_t pin, voidFuncPtr callback, uint32_t mode);
+void noInterrupts();
+void interrupts();
+
+class Print
+{
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t byte) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    virtual void flush() {}
+
+    size_t print(const char *value);
+    size_t print(char value);
+    size_t print(unsigned char value, int base = DEC);
+    size_t print(int value, int base = DEC);
+    size_t print(unsigned int value, int base = DEC);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+    size_t println(const char *value = "");
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+  private:
+    size_t printNumber(unsigned long value, int base);
+};
+
+class Stream : public Print
+{
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+namespace OpenKNX
+{
+    namespace Native
+    {
+        /*
+         * The logger device of the native build.
+         * Output is written to stdout, input is read non-blocking from stdin.
+         */
+        class StdioStream : public Stream
+        {
+          private:
+            int _peeked = -1;
+
+          public:
+            void begin(unsigned long baud);
+            int available() override;
+            int read() override;
+            int peek() override;
+            size_t write(uint8_t byte) override;
+            size_t write(const uint8_t *buffer, size_t size) override;
+            void flush() override;
+            operator bool() { return true; }
+        };
+
+        /*
+         * Emulated core of the current thread: 1 in the loop1() thread (OPENKNX_DUALCORE), otherwise 0
+         */
+        extern thread_local uint8_t core;
+    } // namespace Native
+} // namespace OpenKNX
+
+extern OpenKNX::Native::StdioStream Serial;
@@ -0,0 +1,91 @@
+#include "OpenKNX/Stat/BootProfile.h"
+#ifdef OPENKNX_BOOT_PROFILE
+    #include "OpenKNX/Facade.h"
+
+namespace OpenKNX
+{
+    namespace Stat
+    {
+        uint8_t BootProfile::begin(const char *phase, int8_t module /* = -1 */)
+        {
+            if (_count >= OPENKNX_BOOT_PROFILE_ENTRIES)
+            {
+                _dropped++;
+                return OPENKNX_BOOT_PROFILE_ENTRIES;
+            }
+
+            Entry &entry = _entries[_count];
+            entry.phase = phase;
+            entry.module = module;
+            entry.depth = _depth++;
+            entry.duration = 0;
+            entry.begin = micros();
+            return _count++;
+        }
+
+        void BootProfile::end(uint8_t index)
+        {
+            const uint32_t now = micros();
+            if (_depth > 0) _depth--;
+            if (index >= _count)
+                return;
+
+            _entries[index].duration = now - _entries[index].begin;
+        }
+
+        void BootProfile::finish()
+        {
+            _finished = micros();
+        }
+
+        bool BootProfile::finished()
+        {
+            return _finished != 0;
+        }
+
+        uint32_t BootProfile::total()
+        {
+            return _finished;
+        }
+
+        void BootProfile::show()
+        {
+            logBegin();
+            openknx.logger.logWithPrefixAndValues("Boot", "phase                               start_ms  duration_us");
+            for (uint8_t i = 0; i < _count; i++)
+            {
+                const Entry &entry = _entries[i];
+                std::string phase = std::string(entry.depth * 2, ' ') + entry.phase;
+                if (entry.module >= 0 && entry.module < openknx.modules.count)
+                    phase += " " + openknx.modules.list[entry.module]->name();
+
+                openknx.logger.logWithPrefixAndValues("Boot", "%-32s %11.1f %12u", phase.c_str(), entry.begin / 1000.0, entry.duration);
+            }
+
+            if (_dropped)
+                openknx.logger.logWithPrefixAndValues("Boot", "%u phases not recorded (OPENKNX_BOOT_PROFILE_ENTRIES)", _dropped);
+
+            if (finished())
+                openknx.logger.logWithPrefixAndValues("Boot", "%-32s %11.1f", "first loop", _finished / 1000.0);
+            logEnd();
+        }
+
+    #ifdef BASE_KoDiagnose
+        void BootProfile::showDiagnoseKo()
+        {
+            // max. 14 characters per message
+            openknx.console.writeDiagnoseKo("BOOT %ums", MIN(_finished / 1000, (uint32_t)99999));
+
+            // slowest top level phase
+            int16_t slowest = -1;
+            for (uint8_t i = 0; i < _count; i++)
+                if (_entries[i].depth == 0 && (slowest < 0 || _entries[i].duration > _entries[slowest].duration))
+                    slowest = i;
+
+            if (slowest >= 0)
+                openknx.console.writeDiagnoseKo("%.6s %ums", _entries[slowest].phase, MIN(_entries[slowest].duration / 1000, (uint32_t)99999));
+        }
+    #endif
+    } // namespace Stat
+} // namespace OpenKNX
+#endif
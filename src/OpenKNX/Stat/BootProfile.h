@@ -0,0 +1,75 @@
+#pragma once
+
+#include "OpenKNX/defines.h"
+#include <Arduino.h>
+#include <string>
+
+#ifdef OPENKNX_BOOT_PROFILE
+    #define BOOT_PROFILE_BEGIN(X, PHASE, ...) const uint8_t X = _bootProfile.begin(PHASE, ##__VA_ARGS__);
+    #define BOOT_PROFILE_END(X) _bootProfile.end(X);
+#else
+    #define BOOT_PROFILE_BEGIN(X, PHASE, ...)
+    #define BOOT_PROFILE_END(X)
+#endif
+
+// Max number of recorded phases (incl. init and setup of each module)
+#ifndef OPENKNX_BOOT_PROFILE_ENTRIES
+    #define OPENKNX_BOOT_PROFILE_ENTRIES (16 + 2 * OPENKNX_MAX_MODULES)
+#endif
+
+namespace OpenKNX
+{
+    namespace Stat
+    {
+        /*
+         * Timeline of the boot (Common::init/setup) until the first loop.
+         * Each phase is recorded with its start and duration (µs) in a fixed array, phases can be nested.
+         * Only to be used by core0 before the first loop.
+         */
+        class BootProfile
+        {
+          private:
+            struct Entry
+            {
+                const char *phase;
+                int8_t module; // index in openknx.modules (-1 = none)
+                uint8_t depth;
+                uint32_t begin;
+                uint32_t duration;
+            };
+
+            Entry _entries[OPENKNX_BOOT_PROFILE_ENTRIES];
+            uint8_t _count = 0;
+            uint8_t _depth = 0;
+            uint8_t _dropped = 0;
+            // time of the first loop (0 = still booting)
+            uint32_t _finished = 0;
+
+          public:
+            /*
+             * Start a phase
+             * @param phase name (must be a string literal)
+             * @param module index of the module in openknx.modules
+             * @return handle for end()
+             */
+            uint8_t begin(const char *phase, int8_t module = -1);
+            void end(uint8_t index);
+
+            /*
+             * Record the end of the boot (first loop)
+             */
+            void finish();
+            bool finished();
+
+            /*
+             * Time from power on until the first loop (µs)
+             */
+            uint32_t total();
+
+            void show();
+#ifdef BASE_KoDiagnose
+            void showDiagnoseKo();
+#endif
+        };
+    } // namespace Stat
+} // namespace OpenKNX
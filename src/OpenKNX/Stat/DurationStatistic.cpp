@@ -1,6 +1,5 @@
 #include "OpenKNX/Stat/RuntimeStat.h"
-
-// TODO/LIMITATION: Counter Overflow ist possible and will result in wrong results (for long? runtimes)!
+#include "OpenKNX/Stat/Telemetry.h"
 
 #include "OpenKNX/Log/Logger.h"
 #include "knx.h"
@@ -10,6 +9,7 @@ namespace OpenKNX
     namespace Stat
     {
 
+#ifdef OPENKNX_RUNTIME_STAT_BUCKETS
         uint32_t DurationStatistic::_timeRangeMax[OPENKNX_RUNTIME_STAT_BUCKETN] = {
             OPENKNX_RUNTIME_STAT_BUCKETS,
             0xffffffff, // max value, so we do not need a special case
@@ -25,81 +25,187 @@ namespace OpenKNX
             return i;
         }
 
+        uint32_t DurationStatistic::getHistBucketLower_us(const uint8_t bucketIndex)
+        {
+            return bucketIndex == 0 ? 0 : _timeRangeMax[bucketIndex - 1];
+        }
+
+        uint32_t DurationStatistic::getHistBucketUpper_us(const uint8_t bucketIndex)
+        {
+            return _timeRangeMax[bucketIndex];
+        }
+#else
+    #define STAT_SUB_BUCKETS (1 << OPENKNX_RUNTIME_STAT_PRECISION)
+
+        uint8_t DurationStatistic::calcBucketIndex(const uint32_t value_us)
+        {
+            // one bucket per value
+            if (value_us < STAT_SUB_BUCKETS)
+                return value_us;
+
+            // position of highest bit selects the range, the following bits the bucket within the range
+            const uint8_t exponent = 31 - __builtin_clz(value_us);
+            if (exponent > OPENKNX_RUNTIME_STAT_EXPONENT_MAX)
+                return OPENKNX_RUNTIME_STAT_BUCKETN - 1;
+
+            return ((exponent - OPENKNX_RUNTIME_STAT_PRECISION + 1) << OPENKNX_RUNTIME_STAT_PRECISION) + (value_us >> (exponent - OPENKNX_RUNTIME_STAT_PRECISION)) - STAT_SUB_BUCKETS;
+        }
+
+        uint32_t DurationStatistic::getHistBucketLower_us(const uint8_t bucketIndex)
+        {
+            if (bucketIndex < STAT_SUB_BUCKETS)
+                return bucketIndex;
+
+            if (bucketIndex == OPENKNX_RUNTIME_STAT_BUCKETN - 1)
+                return 1u << (OPENKNX_RUNTIME_STAT_EXPONENT_MAX + 1);
+
+            const uint8_t exponent = (bucketIndex >> OPENKNX_RUNTIME_STAT_PRECISION) + OPENKNX_RUNTIME_STAT_PRECISION - 1;
+            const uint32_t mantissa = (bucketIndex & (STAT_SUB_BUCKETS - 1)) + STAT_SUB_BUCKETS;
+            return mantissa << (exponent - OPENKNX_RUNTIME_STAT_PRECISION);
+        }
+
+        uint32_t DurationStatistic::getHistBucketUpper_us(const uint8_t bucketIndex)
+        {
+            if (bucketIndex == OPENKNX_RUNTIME_STAT_BUCKETN - 1)
+                return 0xffffffff;
+
+            return getHistBucketLower_us(bucketIndex + 1) - 1;
+        }
+#endif
+
         uint32_t DurationStatistic::calcBucketMax(const uint8_t bucketIndex)
         {
-            const uint32_t bucketMax = _timeRangeMax[bucketIndex];
+            const uint32_t bucketMax = getHistBucketUpper_us(bucketIndex);
             return MIN(bucketMax, durationMax_us);
         }
 
         uint32_t DurationStatistic::calcBucketMin(const uint8_t bucketIndex)
         {
-            const uint32_t bucketMin = bucketIndex == 0 ? 0 : _timeRangeMax[bucketIndex - 1];
+            const uint32_t bucketMin = getHistBucketLower_us(bucketIndex);
             return MAX(bucketMin, durationMin_us);
         }
 
         uint32_t DurationStatistic::avg_us()
         {
+            if (_count == 0)
+                return 0;
+
             // round result of `sum_us/_count`
             return (sum_us + _count / 2) / _count;
         }
 
         uint32_t DurationStatistic::estimateMedian_us()
         {
-            // TODO special handling of edge-cases!
+            return estimatePercentile_us(50);
+        }
 
+        uint32_t DurationStatistic::estimatePercentile_us(const uint8_t percent)
+        {
             if (_count == 0)
-                return durationMin_us;
+                return 0;
 
             if (_count <= 2)
-                return (durationMin_us + durationMax_us) / 2;
+                return percent < 50 ? durationMin_us : (percent > 50 ? durationMax_us : (durationMin_us + durationMax_us) / 2);
 
-            uint8_t medianIndex = 0;
-            const uint32_t medianCount = _count / 2;
-            uint32_t cumulatedCountLower = 0;
-            uint32_t cumulatedCountUpper = 0;
+            // the buckets may be halved, so the total is taken from them
+            uint64_t total = 0;
+            for (size_t i = 0; i < OPENKNX_RUNTIME_STAT_BUCKETN; i++)
+                total += durationBucket[i];
+
+            uint8_t index = 0;
+            const uint64_t targetCount = (total * percent + 99) / 100;
+            uint64_t cumulatedCountLower = 0;
+            uint64_t cumulatedCountUpper = 0;
             for (size_t i = 0; i < OPENKNX_RUNTIME_STAT_BUCKETN; i++)
             {
                 cumulatedCountUpper += durationBucket[i];
-                if (cumulatedCountUpper >= medianCount)
+                if (cumulatedCountUpper >= targetCount && durationBucket[i] > 0)
                 {
                     // found the bucket containing the value
-                    medianIndex = i;
+                    index = i;
                     break;
                 }
                 cumulatedCountLower = cumulatedCountUpper;
             }
 
-            // median must be in the closed interval defined by the intersection of selected bucket and [min;max]
-            const uint32_t medianMin = calcBucketMin(medianIndex);
-            const uint32_t medianMax = calcBucketMax(medianIndex);
+            // percentile must be in the closed interval defined by the intersection of selected bucket and [min;max]
+            const uint32_t bucketMin = calcBucketMin(index);
+            const uint32_t bucketMax = calcBucketMax(index);
 
             // "The ``best'' estimate for the mean [and median] is obtained by assuming the data is uniformly spread within each interval"
             // [http://www.cs.uni.edu/~campbell/stat/histrev2.html accessed 2023-08-06]
             // Using information of min- and maximum value can reduce the interval and thereby improve the result.
-            double factor = 1.0 * (medianCount - cumulatedCountLower) / durationBucket[medianIndex];
-            return medianMin + (medianMax - medianMin) * factor;
-
-            // TODO check usage of one side open interval?
+            double factor = 1.0 * (targetCount - cumulatedCountLower) / durationBucket[index];
+            return bucketMin + (bucketMax - bucketMin) * factor;
         }
 
-        uint32_t DurationStatistic::sum_ms()
+        uint64_t DurationStatistic::sum_ms()
         {
             return sum_us / 1000;
         }
 
-        uint32_t DurationStatistic::getHistBucket(const uint8_t bucketIndex)
+        void DurationStatistic::merge(const DurationStatistic &other)
         {
-            return durationBucket[bucketIndex];
+            if (other._count == 0)
+                return;
+
+            for (size_t i = 0; i < OPENKNX_RUNTIME_STAT_BUCKETN; i++)
+            {
+                // halve on overflow
+                if (durationBucket[i] > UINT32_MAX - other.durationBucket[i])
+                    for (size_t j = 0; j < OPENKNX_RUNTIME_STAT_BUCKETN; j++)
+                        durationBucket[j] >>= 1;
+
+                durationBucket[i] += other.durationBucket[i];
+            }
+            durationMax_us = MAX(durationMax_us, other.durationMax_us);
+            durationMin_us = MIN(durationMin_us, other.durationMin_us);
+            sum_us += other.sum_us;
+            _count += other._count;
         }
 
-        uint32_t DurationStatistic::getHistBucketUpper_us(const uint8_t bucketIndex)
+        void DurationStatistic::reset()
         {
-            return _timeRangeMax[bucketIndex];
+            *this = DurationStatistic();
+        }
+
+        void DurationStatistic::exportStat(Print &out)
+        {
+            writeTelemetry<uint64_t>(out, _count);
+            writeTelemetry<uint64_t>(out, sum_us);
+            writeTelemetry<uint32_t>(out, durationMin_us);
+            writeTelemetry<uint32_t>(out, durationMax_us);
+
+            // only used buckets
+            uint8_t used = 0;
+            for (size_t i = 0; i < OPENKNX_RUNTIME_STAT_BUCKETN; i++)
+                if (durationBucket[i] > 0)
+                    used++;
+
+            writeTelemetry<uint8_t>(out, used);
+            for (size_t i = 0; i < OPENKNX_RUNTIME_STAT_BUCKETN; i++)
+            {
+                if (durationBucket[i] == 0)
+                    continue;
+
+                writeTelemetry<uint8_t>(out, i);
+                writeTelemetry<uint32_t>(out, durationBucket[i]);
+            }
+        }
+
+        uint32_t DurationStatistic::getHistBucket(const uint8_t bucketIndex)
+        {
+            return durationBucket[bucketIndex];
         }
 
         void DurationStatistic::measure(const uint32_t duration_us)
         {
-            durationBucket[calcBucketIndex(duration_us)]++;
+            const uint8_t index = calcBucketIndex(duration_us);
+            if (durationBucket[index] == UINT32_MAX)
+                for (size_t i = 0; i < OPENKNX_RUNTIME_STAT_BUCKETN; i++)
+                    durationBucket[i] >>= 1;
+
+            durationBucket[index]++;
             durationMax_us = MAX(durationMax_us, duration_us);
             durationMin_us = MIN(durationMin_us, duration_us);
             sum_us += duration_us;
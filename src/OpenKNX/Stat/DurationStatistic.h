@@ -2,13 +2,28 @@
 
 #include <Arduino.h>
 
-#ifndef OPENKNX_RUNTIME_STAT_BUCKETS
-    #define OPENKNX_RUNTIME_STAT_BUCKETS 50, 100, 200, 400, 600, 800, 1000, 1500, 2000, 3000, 4000, 5000, 6000, 7000, 10000
-#endif
-#ifndef OPENKNX_RUNTIME_STAT_BUCKETN
-    #define OPENKNX_RUNTIME_STAT_BUCKETN 16
+#ifdef OPENKNX_RUNTIME_STAT_BUCKETS
+    // fixed bucket limits, e.g. 50, 100, 200, 400, 600, 800, 1000, 1500, 2000, 3000, 4000, 5000, 6000, 7000, 10000 (linear lookup)
+    #ifndef OPENKNX_RUNTIME_STAT_BUCKETN
+        #define OPENKNX_RUNTIME_STAT_BUCKETN 16
+    #endif
+#else
+    /*
+     * Log-linear buckets (HDR histogram): every power of two range [2^e; 2^(e+1)[ is divided into
+     * 2^OPENKNX_RUNTIME_STAT_PRECISION buckets of equal width, values below 2^OPENKNX_RUNTIME_STAT_PRECISION have own buckets.
+     * So the relative error is bounded by 2^-OPENKNX_RUNTIME_STAT_PRECISION and the index is calculated in constant time.
+     * Values from 2^(OPENKNX_RUNTIME_STAT_EXPONENT_MAX+1) µs (16.8 s) are collected in the last bucket.
+     */
+    #ifndef OPENKNX_RUNTIME_STAT_PRECISION
+        #define OPENKNX_RUNTIME_STAT_PRECISION 2
+    #endif
+    #define OPENKNX_RUNTIME_STAT_EXPONENT_MAX 23
+    #define OPENKNX_RUNTIME_STAT_BUCKETN (((OPENKNX_RUNTIME_STAT_EXPONENT_MAX - OPENKNX_RUNTIME_STAT_PRECISION + 2) << OPENKNX_RUNTIME_STAT_PRECISION) + 1)
 #endif
 
+// bucket indices are stored as uint8_t (log-linear: OPENKNX_RUNTIME_STAT_PRECISION 0-3)
+static_assert(OPENKNX_RUNTIME_STAT_BUCKETN <= 255, "OPENKNX_RUNTIME_STAT_BUCKETN must not exceed 255");
+
 namespace OpenKNX
 {
     namespace Stat
@@ -33,11 +48,13 @@ namespace OpenKNX
             uint32_t calcBucketMin(const uint8_t bucketIndex);
 
           public:
+#ifdef OPENKNX_RUNTIME_STAT_BUCKETS
             // define the upper (included) limit of every time buckets. Last value must be maximum value of data-type.
             static uint32_t _timeRangeMax[OPENKNX_RUNTIME_STAT_BUCKETN];
+#endif
 
             // the number of collected durations
-            uint32_t _count = 0;
+            uint64_t _count = 0;
 
             // the overall sum of all collected durations; unit µs (microseconds)
             uint64_t sum_us = 0;
@@ -48,8 +65,9 @@ namespace OpenKNX
             // longest of all collected durations; unit µs (microseconds)
             uint32_t durationMax_us = 0;
 
-            // the histogram data; number of collected durations within buckets (defined by upper limit, see _timeRangeMax)
-            uint32_t durationBucket[OPENKNX_RUNTIME_STAT_BUCKETN];
+            // the histogram data; number of collected durations within buckets (see getHistBucketLower_us/getHistBucketUpper_us)
+            // all buckets are halved if one is full, so the distribution stays valid
+            uint32_t durationBucket[OPENKNX_RUNTIME_STAT_BUCKETN] = {};
 
             /// Update statistic based on a duration measurement.
             /// Will increase count, sum, update min/max and include in histogram.
@@ -64,15 +82,35 @@ namespace OpenKNX
             /// @return a duration value; unit µs (microseconds)
             uint32_t estimateMedian_us();
 
+            /// @brief Calculate an estimation of a percentile of the durations (interpolated within the histogram bucket).
+            /// @param percent e.g. 95 for p95
+            /// @return a duration value; unit µs (microseconds)
+            uint32_t estimatePercentile_us(const uint8_t percent);
+
             /// @brief Get sum of all collected durations.
             /// @return a duration value; unit ms (milliseconds)
-            uint32_t sum_ms();
+            uint64_t sum_ms();
+
+            /// @brief Add the durations collected by other.
+            void merge(const DurationStatistic &other);
+
+            /// @brief Remove all collected durations.
+            void reset();
+
+            /// @brief Write the statistic to a telemetry snapshot.
+            /// Format: COUNT[8] SUM_US[8] MIN_US[4] MAX_US[4] USED_BUCKETS[1] (INDEX[1] COUNT[4])*
+            void exportStat(Print &out);
 
             /// @brief Get the number of durations collected in the bucket.
             /// @param bucketIndex
             /// @return
             uint32_t getHistBucket(const uint8_t bucketIndex);
 
+            /// @brief Get the minimum duration included in the bucket.
+            /// @param bucketIndex
+            /// @return a duration value; unit µs (microseconds)
+            static uint32_t getHistBucketLower_us(const uint8_t bucketIndex);
+
             /// @brief Get the maximum duration included in the bucket.
             /// @param bucketIndex
             /// @return a duration value; unit µs (microseconds)
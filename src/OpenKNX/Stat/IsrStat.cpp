@@ -0,0 +1,75 @@
+#include "OpenKNX/Stat/IsrStat.h"
+#include "OpenKNX/Facade.h"
+#include "OpenKNX/Stat/Telemetry.h"
+
+namespace OpenKNX
+{
+    namespace Stat
+    {
+        uint32_t IsrStat::ticksPerMicrosecond()
+        {
+#if defined(ARDUINO_ARCH_ESP32)
+            return getCpuFrequencyMhz();
+#elif defined(OPENKNX_NATIVE)
+            return 1000;
+#else
+            return 1;
+#endif
+        }
+
+        IsrStat::Values IsrStat::read()
+        {
+            Values values;
+            uint32_t sequence;
+            do
+            {
+                // wait while the handler is writing (only possible on the other core)
+                while ((sequence = _sequence) & 1)
+                    ;
+                __sync_synchronize();
+                values = _values;
+                __sync_synchronize();
+            } while (sequence != _sequence);
+
+            if (_resetRequest)
+                return Values();
+
+            return values;
+        }
+
+        void IsrStat::reset()
+        {
+            _since = millis();
+            _resetRequest = true;
+        }
+
+        void IsrStat::exportStat(Print &out)
+        {
+            const Values values = read();
+            writeTelemetry<uint16_t>(out, ticksPerMicrosecond());
+            writeTelemetry<uint32_t>(out, values.count);
+            writeTelemetry<uint32_t>(out, values.max);
+            writeTelemetry<uint64_t>(out, values.total);
+            writeTelemetry<uint32_t>(out, millis() - _since);
+        }
+
+        void IsrStat::showStatHeader()
+        {
+            openknx.logger.logWithPrefixAndValues("IsrStat", "@        count       avg_us       max_us     total_ms   load_%%");
+        }
+
+        void IsrStat::showStat(std::string label, const uint8_t core /*= 0*/)
+        {
+            const Values values = read();
+            const double perUs = ticksPerMicrosecond();
+            const double total_us = values.total / perUs;
+            const uint32_t period_ms = millis() - _since;
+            openknx.logger.logWithPrefixAndValues(label, "%d %12.0f %12.2f %12.1f %12.1f %8.3f", core,
+                                                  (double)values.count,
+                                                  values.count ? total_us / values.count : 0.0,
+                                                  values.max / perUs,
+                                                  total_us / 1000,
+                                                  period_ms ? total_us / period_ms / 10 : 0.0);
+        }
+    } // namespace Stat
+} // namespace OpenKNX
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <Arduino.h>
+#include <string>
+#ifdef ARDUINO_ARCH_RP2040
+    #include <hardware/timer.h>
+#endif
+#ifdef OPENKNX_NATIVE
+    #include <chrono>
+#endif
+
+#ifdef OPENKNX_RUNTIME_STAT
+    #define ISR_MEASURE(X) OpenKNX::Stat::IsrStat::Scope _isrMeasure(X);
+#else
+    #define ISR_MEASURE(X)
+#endif
+
+namespace OpenKNX
+{
+    namespace Stat
+    {
+        /*
+         * Runtime of an interrupt handler (count, max, total).
+         *
+         * The handler is the only writer, so no lock is needed: the values are enclosed by a sequence number
+         * (odd while the handler writes) and the reader retries until it got a consistent copy. A reset is only
+         * requested by the reader and done by the handler on its next run.
+         *
+         * The durations are measured in ticks of the cycle counter (ESP32), the µs timer (RP2040, SAMD) or
+         * in ns (native). Durations below one tick are still correct on average.
+         */
+        class IsrStat
+        {
+          public:
+            struct Values
+            {
+                uint32_t count = 0;
+                uint32_t max = 0;
+                uint64_t total = 0;
+            };
+
+            class Scope
+            {
+              private:
+                IsrStat &_stat;
+                const uint32_t _begin;
+
+              public:
+                inline Scope(IsrStat &stat) : _stat(stat), _begin(ticks()) {}
+                inline ~Scope() { _stat.measure(ticks() - _begin); }
+            };
+
+          private:
+            volatile uint32_t _sequence = 0;
+            volatile bool _resetRequest = false;
+            Values _values;
+            // millis() of the last reset
+            uint32_t _since = 0;
+
+          public:
+            static inline uint32_t ticks()
+            {
+#if defined(ARDUINO_ARCH_ESP32)
+                return ESP.getCycleCount();
+#elif defined(ARDUINO_ARCH_RP2040)
+                return time_us_32();
+#elif defined(OPENKNX_NATIVE)
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+                return micros();
+#endif
+            }
+
+            static uint32_t ticksPerMicrosecond();
+
+            /*
+             * Record a run of the handler, only to be called by the handler itself
+             */
+            inline void measure(const uint32_t duration)
+            {
+                _sequence++;
+                __sync_synchronize();
+                if (_resetRequest)
+                {
+                    _values = Values();
+                    _resetRequest = false;
+                }
+                _values.count++;
+                _values.total += duration;
+                if (duration > _values.max)
+                    _values.max = duration;
+                __sync_synchronize();
+                _sequence++;
+            }
+
+            /*
+             * Consistent copy of the values (safe against the handler on any core)
+             */
+            Values read();
+            void reset();
+
+            /*
+             * Write to a telemetry snapshot
+             * Format: TICKS_PER_US[2] COUNT[4] MAX[4] TOTAL[8] PERIOD_MS[4] (ticks, period since reset)
+             */
+            void exportStat(Print &out);
+
+            static void showStatHeader();
+            void showStat(std::string label, const uint8_t core = 0);
+        };
+    } // namespace Stat
+} // namespace OpenKNX
@@ -0,0 +1,113 @@
+#include "OpenKNX/Stat/LoopOverruns.h"
+#ifdef OPENKNX_LOOPTIME_OVERRUNS
+    #include "OpenKNX/Facade.h"
+
+namespace OpenKNX
+{
+    namespace Stat
+    {
+        void LoopOverruns::begin()
+        {
+            memset(_sections, 0, sizeof(uint32_t) * (OPENKNX_LOOP_SECTION_MODULE + openknx.modules.count));
+            _begin = micros();
+        }
+
+        void LoopOverruns::end(const bool expected)
+        {
+            const uint32_t duration = micros() - _begin;
+            if (duration < OPENKNX_LOOPTIME_WARNING * 1000)
+                return;
+
+            Event &event = _events[_next];
+            event.time = millis();
+            event.duration = duration;
+            event.other = duration;
+            event.expected = expected;
+            for (uint8_t j = 0; j < OPENKNX_LOOP_OVERRUN_SECTIONS; j++)
+                event.sectionDuration[j] = 0;
+
+            // keep the longest sections (sorted)
+            for (uint8_t i = 0; i < OPENKNX_LOOP_SECTION_MODULE + openknx.modules.count; i++)
+            {
+                event.other -= MIN(event.other, _sections[i]);
+                for (uint8_t j = 0; j < OPENKNX_LOOP_OVERRUN_SECTIONS; j++)
+                {
+                    if (_sections[i] <= event.sectionDuration[j])
+                        continue;
+
+                    for (uint8_t k = OPENKNX_LOOP_OVERRUN_SECTIONS - 1; k > j; k--)
+                    {
+                        event.section[k] = event.section[k - 1];
+                        event.sectionDuration[k] = event.sectionDuration[k - 1];
+                    }
+                    event.section[j] = i;
+                    event.sectionDuration[j] = _sections[i];
+                    break;
+                }
+            }
+
+            _next = (_next + 1) % OPENKNX_LOOPTIME_OVERRUNS;
+            _count++;
+            if (expected)
+                _expectedCount++;
+        }
+
+        std::string LoopOverruns::sectionName(uint8_t section)
+        {
+            switch (section)
+            {
+                case OPENKNX_LOOP_SECTION_CONSOLE:
+                    return "Console";
+                case OPENKNX_LOOP_SECTION_KNX:
+                    return "KnxStack";
+                case OPENKNX_LOOP_SECTION_FLASH:
+                    return "Flash";
+            }
+
+            section -= OPENKNX_LOOP_SECTION_MODULE;
+            return section < openknx.modules.count ? openknx.modules.list[section]->name() : "?";
+        }
+
+        void LoopOverruns::show()
+        {
+            const uint8_t count = MIN(_count, (uint32_t)OPENKNX_LOOPTIME_OVERRUNS);
+            logBegin();
+            openknx.logger.logWithPrefixAndValues("Overrun", "%u loops took %ums or longer (%u expected), last %u:", _count, OPENKNX_LOOPTIME_WARNING, _expectedCount, count);
+            openknx.logger.logWithPrefixAndValues("Overrun", "   uptime_s  total_us  sections (us, * expected)");
+
+            // newest first
+            for (uint8_t i = 0; i < count; i++)
+            {
+                const Event &event = _events[(_next + OPENKNX_LOOPTIME_OVERRUNS - 1 - i) % OPENKNX_LOOPTIME_OVERRUNS];
+                std::string sections;
+                for (uint8_t j = 0; j < OPENKNX_LOOP_OVERRUN_SECTIONS && event.sectionDuration[j] > 0; j++)
+                    sections += sectionName(event.section[j]) + "=" + std::to_string(event.sectionDuration[j]) + " ";
+
+                openknx.logger.logWithPrefixAndValues("Overrun", "%11.3f %9u%c %sother=%u", event.time / 1000.0, event.duration, event.expected ? '*' : ' ', sections.c_str(), event.other);
+            }
+            logEnd();
+        }
+
+    #ifdef BASE_KoDiagnose
+        void LoopOverruns::showDiagnoseKo()
+        {
+            // max. 14 characters per message
+            if (_count == 0)
+            {
+                openknx.console.writeDiagnoseKo("OVR none");
+                return;
+            }
+
+            const Event &event = _events[(_next + OPENKNX_LOOPTIME_OVERRUNS - 1) % OPENKNX_LOOPTIME_OVERRUNS];
+            openknx.console.writeDiagnoseKo("OVR %u %ums", MIN(_count, (uint32_t)9999), MIN(event.duration / 1000, (uint32_t)999));
+            // longest section, * if expected
+            const char *expected = event.expected ? "*" : "";
+            if (event.sectionDuration[0] > 0)
+                openknx.console.writeDiagnoseKo("%.6s %ums%s", sectionName(event.section[0]).c_str(), MIN(event.sectionDuration[0] / 1000, (uint32_t)9999), expected);
+            else if (event.expected)
+                openknx.console.writeDiagnoseKo("other %ums*", MIN(event.other / 1000, (uint32_t)9999));
+        }
+    #endif
+    } // namespace Stat
+} // namespace OpenKNX
+#endif
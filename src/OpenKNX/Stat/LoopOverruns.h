@@ -0,0 +1,80 @@
+#pragma once
+
+#include "OpenKNX/defines.h"
+#include <Arduino.h>
+#include <string>
+
+#ifdef OPENKNX_LOOPTIME_OVERRUNS
+    #define LOOP_SECTION_BEGIN(X) const uint32_t X = micros();
+    #define LOOP_SECTION_END(X, SECTION) _loopOverruns.add(SECTION, micros() - X);
+#else
+    #define LOOP_SECTION_BEGIN(X)
+    #define LOOP_SECTION_END(X, SECTION)
+#endif
+
+// Sections of the loop (followed by one section per module)
+#define OPENKNX_LOOP_SECTION_CONSOLE 0
+#define OPENKNX_LOOP_SECTION_KNX 1
+#define OPENKNX_LOOP_SECTION_FLASH 2
+#define OPENKNX_LOOP_SECTION_MODULE 3
+
+// Number of sections stored per overrun (the longest ones)
+#define OPENKNX_LOOP_OVERRUN_SECTIONS 3
+
+#ifdef OPENKNX_LOOPTIME_OVERRUNS
+namespace OpenKNX
+{
+    namespace Stat
+    {
+        /*
+         * Recorder of loops taking OPENKNX_LOOPTIME_WARNING or longer.
+         * The time of each section of the current loop is summed up. On an overrun the longest sections are stored
+         * in a ring of the last OPENKNX_LOOPTIME_OVERRUNS events. Loops known to be slow (e.g. flash save, console
+         * command), whose warning is skipped, are recorded as expected. Only to be used by core0.
+         */
+        class LoopOverruns
+        {
+          private:
+            struct Event
+            {
+                uint32_t time; // millis()
+                uint32_t duration;
+                uint32_t other; // not in a section
+                bool expected;  // warning skipped (Common::skipLooptimeWarning)
+                uint8_t section[OPENKNX_LOOP_OVERRUN_SECTIONS];
+                uint32_t sectionDuration[OPENKNX_LOOP_OVERRUN_SECTIONS];
+            };
+
+            uint32_t _sections[OPENKNX_LOOP_SECTION_MODULE + OPENKNX_MAX_MODULES] = {};
+            uint32_t _begin = 0;
+            Event _events[OPENKNX_LOOPTIME_OVERRUNS];
+            uint8_t _next = 0;
+            uint32_t _count = 0;
+            uint32_t _expectedCount = 0;
+
+            static std::string sectionName(uint8_t section);
+
+          public:
+            /*
+             * Start of the loop
+             */
+            void begin();
+            inline void add(const uint8_t section, const uint32_t duration)
+            {
+                _sections[section] += duration;
+            }
+
+            /*
+             * End of the loop, records an event if the loop took OPENKNX_LOOPTIME_WARNING or longer
+             * @param expected the loop is known to be slow (the warning is skipped)
+             */
+            void end(const bool expected);
+
+            void show();
+    #ifdef BASE_KoDiagnose
+            void showDiagnoseKo();
+    #endif
+        };
+    } // namespace Stat
+} // namespace OpenKNX
+#endif
@@ -1,11 +1,8 @@
 #include "OpenKNX/Stat/RuntimeStat.h"
 #include "OpenKNX/Facade.h"
-
-// TODO/LIMITATION: Counter Overflow ist possible and will result in wrong results (for long? runtimes)!
+#include "OpenKNX/Stat/Telemetry.h"
 
 // TODO/Feature: Allow pause measuring for special case handling
-// TODO/Feature: add measuring for core1
-// TODO/Improvement: check integration of RuntimeStat in Module
 // TODO/Feature: Allow measurement of Channels
 
 namespace OpenKNX
@@ -29,7 +26,65 @@ namespace OpenKNX
             // store end only once at the beginning, as getting the time twice might increase error
             _end_us = micros();
 
-            _run.measure(_end_us - _begin_us);
+            const uint32_t duration_us = _end_us - _begin_us;
+            _run.measure(duration_us);
+
+#ifdef OPENKNX_RUNTIME_STAT_WINDOWS
+            _minute.measure(duration_us);
+
+            if (_minute._count == 1 && _minuteBegin_us == 0)
+                _minuteBegin_us = _end_us;
+            else if (_end_us - _minuteBegin_us >= 60000000)
+                closeMinute();
+#endif
+        }
+
+#ifdef OPENKNX_RUNTIME_STAT_WINDOWS
+        /**
+         * The minute is completed on the first measurement after its end, the hour after 60 minutes
+         */
+        void RuntimeStat::closeMinute()
+        {
+            _lastMinute = summarize(_minute);
+            _hour.merge(_minute);
+            _minute.reset();
+            _minuteBegin_us = _end_us;
+
+            if (++_minutes >= 60)
+            {
+                _lastHour = summarize(_hour);
+                _hour.reset();
+                _minutes = 0;
+            }
+        }
+
+        RuntimeStat::Window RuntimeStat::summarize(DurationStatistic &statistic)
+        {
+            Window window;
+            window.count = MIN(statistic._count, (uint64_t)UINT32_MAX);
+            window.avg_us = statistic.avg_us();
+            window.p95_us = statistic.estimatePercentile_us(95);
+            window.max_us = statistic.durationMax_us;
+            return window;
+        }
+#endif
+
+        void RuntimeStat::reset()
+        {
+            *this = RuntimeStat();
+        }
+
+        void RuntimeStat::exportStat(Print &out)
+        {
+            _run.exportStat(out);
+            _wait.exportStat(out);
+            for (const Window &window : {_lastMinute, _lastHour})
+            {
+                writeTelemetry<uint32_t>(out, window.count);
+                writeTelemetry<uint32_t>(out, window.avg_us);
+                writeTelemetry<uint32_t>(out, window.p95_us);
+                writeTelemetry<uint32_t>(out, window.max_us);
+            }
         }
 
         void RuntimeStat::showStatHeader()
@@ -41,17 +96,37 @@ namespace OpenKNX
         {
             if (stat)
             {
-                openknx.logger.logWithPrefixAndValues(label, "%d stat  count    # %12d %12d", core, _run._count, _wait._count);
-                openknx.logger.logWithPrefixAndValues(label, "%d stat    sum   ms %12d %12d", core, _run.sum_ms(), _wait.sum_ms());
+                // 64 bit counters
+                openknx.logger.logWithPrefixAndValues(label, "%d stat  count    # %12.0f %12.0f", core, (double)_run._count, (double)_wait._count);
+                openknx.logger.logWithPrefixAndValues(label, "%d stat    sum   ms %12.0f %12.0f", core, (double)_run.sum_ms(), (double)_wait.sum_ms());
                 openknx.logger.logWithPrefixAndValues(label, "%d stat    min   us %12d %12d", core, _run.durationMin_us, _wait.durationMin_us);
                 openknx.logger.logWithPrefixAndValues(label, "%d stat    avg   us %12d %12d", core, _run.avg_us(), _wait.avg_us());
-                openknx.logger.logWithPrefixAndValues(label, "%d stat   ~med   us %12d %12d", core, _run.estimateMedian_us(), _wait.estimateMedian_us());
+                openknx.logger.logWithPrefixAndValues(label, "%d stat   ~p50   us %12d %12d", core, _run.estimatePercentile_us(50), _wait.estimatePercentile_us(50));
+                openknx.logger.logWithPrefixAndValues(label, "%d stat   ~p95   us %12d %12d", core, _run.estimatePercentile_us(95), _wait.estimatePercentile_us(95));
+                openknx.logger.logWithPrefixAndValues(label, "%d stat   ~p99   us %12d %12d", core, _run.estimatePercentile_us(99), _wait.estimatePercentile_us(99));
                 openknx.logger.logWithPrefixAndValues(label, "%d stat    max   us %12d %12d", core, _run.durationMax_us, _wait.durationMax_us);
+
+#ifdef OPENKNX_RUNTIME_STAT_WINDOWS
+                // run of the last completed minute and hour
+                openknx.logger.logWithPrefixAndValues(label, "%d 1min  count    # %12d", core, _lastMinute.count);
+                openknx.logger.logWithPrefixAndValues(label, "%d 1min    avg   us %12d", core, _lastMinute.avg_us);
+                openknx.logger.logWithPrefixAndValues(label, "%d 1min   ~p95   us %12d", core, _lastMinute.p95_us);
+                openknx.logger.logWithPrefixAndValues(label, "%d 1min    max   us %12d", core, _lastMinute.max_us);
+                openknx.logger.logWithPrefixAndValues(label, "%d 1h    count    # %12d", core, _lastHour.count);
+                openknx.logger.logWithPrefixAndValues(label, "%d 1h      avg   us %12d", core, _lastHour.avg_us);
+                openknx.logger.logWithPrefixAndValues(label, "%d 1h     ~p95   us %12d", core, _lastHour.p95_us);
+                openknx.logger.logWithPrefixAndValues(label, "%d 1h      max   us %12d", core, _lastHour.max_us);
+#endif
             }
             if (hist)
             {
                 for (size_t i = 0; i < OPENKNX_RUNTIME_STAT_BUCKETN1; i++)
                 {
+#ifndef OPENKNX_RUNTIME_STAT_BUCKETS
+                    // many small log-linear buckets: show only used ones
+                    if (_run.getHistBucket(i) == 0 && _wait.getHistBucket(i) == 0)
+                        continue;
+#endif
                     openknx.logger.logWithPrefixAndValues(label, "%d hist %6d  #<= %12d %12d", core, DurationStatistic::getHistBucketUpper_us(i), _run.getHistBucket(i), _wait.getHistBucket(i));
                 }
                 openknx.logger.logWithPrefixAndValues(label, "%d hist INFu32  #<= %12d %12d", core, _run.getHistBucket(OPENKNX_RUNTIME_STAT_BUCKETN1), _wait.getHistBucket(OPENKNX_RUNTIME_STAT_BUCKETN1));
@@ -21,17 +21,47 @@ namespace OpenKNX
         class RuntimeStat
         {
           private:
+            // result of a completed time window
+            struct Window
+            {
+                uint32_t count = 0;
+                uint32_t avg_us = 0;
+                uint32_t p95_us = 0;
+                uint32_t max_us = 0;
+            };
+
             uint32_t _begin_us = 0;
             uint32_t _end_us = 0;
 
             DurationStatistic _run = DurationStatistic();
             DurationStatistic _wait = DurationStatistic();
 
+            Window _lastMinute;
+            Window _lastHour;
+#ifdef OPENKNX_RUNTIME_STAT_WINDOWS
+            // run durations of the current minute and hour (tumbling windows)
+            DurationStatistic _minute = DurationStatistic();
+            DurationStatistic _hour = DurationStatistic();
+            uint32_t _minuteBegin_us = 0;
+            uint8_t _minutes = 0;
+
+            void closeMinute();
+            static Window summarize(DurationStatistic &statistic);
+#endif
+
           public:
             static void showStatHeader();
 
             void measureTimeBegin();
             void measureTimeEnd();
+            void reset();
+
+            /*
+             * Write to a telemetry snapshot
+             * Format: RUN WAIT (see DurationStatistic::exportStat) LAST_MINUTE LAST_HOUR (COUNT[4] AVG_US[4] P95_US[4] MAX_US[4])
+             * The windows are 0 without OPENKNX_RUNTIME_STAT_WINDOWS.
+             */
+            void exportStat(Print &out);
             void showStat(std::string label, const uint8_t core = 0, const bool stat = true, const bool hist = false);
         };
     } // namespace Stat
@@ -0,0 +1,138 @@
+#include "OpenKNX/Stat/Telemetry.h"
+#include "OpenKNX/Facade.h"
+#include "OpenKNX/Stat/IsrStat.h"
+#include "OpenKNX/Stat/RuntimeStat.h"
+
+// bytes per hex line of the console output
+#define TELEMETRY_LINE 32
+
+namespace OpenKNX
+{
+    namespace Stat
+    {
+        Telemetry::~Telemetry()
+        {
+            free(_data);
+        }
+
+        size_t Telemetry::write(uint8_t byte)
+        {
+            return write(&byte, 1);
+        }
+
+        size_t Telemetry::write(const uint8_t *buffer, size_t size)
+        {
+            // a skipped field would misalign all following ones, so the snapshot ends here
+            if (_truncated)
+                return 0;
+
+            if (_size + size > 0xFFFF)
+            {
+                truncate();
+                return 0;
+            }
+
+            if (_size + size > _capacity)
+            {
+                const uint16_t capacity = MIN(MAX(_capacity * 2, _size + size), 0xFFFF);
+                uint8_t *data = (uint8_t *)realloc(_data, capacity);
+                if (data == nullptr)
+                {
+                    truncate();
+                    return 0;
+                }
+
+                _data = data;
+                _capacity = capacity;
+            }
+
+            memcpy(_data + _size, buffer, size);
+            _size += size;
+            return size;
+        }
+
+        void Telemetry::begin(const int32_t freeMemoryMin, const int32_t freeStackMin, const int32_t freeStackMin1)
+        {
+            _size = 0;
+            _truncated = false;
+            print("OKT");
+            writeTelemetry<uint8_t>(*this, OPENKNX_TELEMETRY_VERSION);
+            writeTelemetry<uint32_t>(*this, millis());
+            writeTelemetry<int32_t>(*this, freeMemoryMin);
+            writeTelemetry<int32_t>(*this, freeStackMin);
+            writeTelemetry<int32_t>(*this, freeStackMin1);
+#ifdef OPENKNX_RUNTIME_STAT_BUCKETS
+            writeTelemetry<uint8_t>(*this, 0xFF);
+            writeTelemetry<uint8_t>(*this, OPENKNX_RUNTIME_STAT_BUCKETN);
+            for (uint8_t i = 0; i < OPENKNX_RUNTIME_STAT_BUCKETN - 1; i++)
+                writeTelemetry<uint32_t>(*this, DurationStatistic::getHistBucketUpper_us(i));
+#else
+            writeTelemetry<uint8_t>(*this, OPENKNX_RUNTIME_STAT_PRECISION);
+            writeTelemetry<uint8_t>(*this, OPENKNX_RUNTIME_STAT_BUCKETN);
+#endif
+        }
+
+        void Telemetry::truncate()
+        {
+            _truncated = true;
+            if (_size > 3)
+                _data[3] |= OPENKNX_TELEMETRY_TRUNCATED;
+        }
+
+        void Telemetry::record(const uint8_t type, const std::string &label, const uint8_t core)
+        {
+            const uint8_t length = MIN(label.length(), (size_t)0xFF);
+            writeTelemetry<uint8_t>(*this, type);
+            writeTelemetry<uint8_t>(*this, core);
+            writeTelemetry<uint8_t>(*this, length);
+            write((const uint8_t *)label.c_str(), length);
+        }
+
+        void Telemetry::add(const std::string &label, const uint8_t core, RuntimeStat &stat)
+        {
+            record(OPENKNX_TELEMETRY_RUNTIME, label, core);
+            stat.exportStat(*this);
+        }
+
+        void Telemetry::add(const std::string &label, const uint8_t core, IsrStat &stat)
+        {
+            record(OPENKNX_TELEMETRY_ISR, label, core);
+            stat.exportStat(*this);
+        }
+
+        uint16_t Telemetry::size()
+        {
+            return _size;
+        }
+
+        bool Telemetry::truncated()
+        {
+            return _truncated;
+        }
+
+        uint16_t Telemetry::read(const uint16_t offset, uint8_t *buffer, const uint16_t length)
+        {
+            if (offset >= _size)
+                return 0;
+
+            const uint16_t count = MIN(length, (uint16_t)(_size - offset));
+            memcpy(buffer, _data + offset, count);
+            return count;
+        }
+
+        void Telemetry::show()
+        {
+            char line[TELEMETRY_LINE * 2 + 1];
+            openknx.logger.logWithPrefixAndValues("Telemetry", "begin %u", _size);
+            for (uint32_t offset = 0; offset < _size; offset += TELEMETRY_LINE)
+            {
+                const uint16_t count = MIN((uint16_t)TELEMETRY_LINE, (uint16_t)(_size - offset));
+                for (uint16_t i = 0; i < count; i++)
+                    sprintf(line + i * 2, "%02X", _data[offset + i]);
+
+                openknx.logger.logWithPrefix("Telemetry", line);
+            }
+            openknx.logger.logWithPrefixAndValues("Telemetry", _truncated ? "end truncated" : "end");
+        }
+    } // namespace Stat
+} // namespace OpenKNX
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+#include <string>
+
+// KNX function property to read the snapshot in chunks
+#ifndef OPENKNX_TELEMETRY_OBJECT
+    #define OPENKNX_TELEMETRY_OBJECT 160
+#endif
+#ifndef OPENKNX_TELEMETRY_PROPERTY
+    #define OPENKNX_TELEMETRY_PROPERTY 240
+#endif
+
+#define OPENKNX_TELEMETRY_VERSION 1
+#define OPENKNX_TELEMETRY_TRUNCATED 0x80
+#define OPENKNX_TELEMETRY_RUNTIME 1
+#define OPENKNX_TELEMETRY_ISR 2
+
+namespace OpenKNX
+{
+    namespace Stat
+    {
+        class RuntimeStat;
+        class IsrStat;
+
+        /*
+         * Append a value to the snapshot (all supported platforms are little endian)
+         */
+        template <typename T>
+        inline void writeTelemetry(Print &out, const T value)
+        {
+            out.write((const uint8_t *)&value, sizeof(T));
+        }
+
+        /*
+         * Binary snapshot of all runtime statistics for the host (telemetry_decode.py).
+         *
+         * Format (little endian):
+         *   HEADER: "OKT" VERSION[1] UPTIME_MS[4] FREE_MEMORY_MIN[4] FREE_STACK_MIN[4] FREE_STACK_MIN1[4]
+         *           PRECISION[1] BUCKETS[1] (PRECISION 0xFF: fixed buckets, followed by BUCKETS-1 upper limits [4])
+         *   RECORD: TYPE[1] CORE[1] LABEL_LENGTH[1] LABEL DATA (see RuntimeStat::exportStat, IsrStat::exportStat)
+         *
+         * The snapshot is kept until the next one is taken, so it can be read in chunks.
+         * If it does not fit (64 KiB or out of memory), it ends after the last written byte and
+         * OPENKNX_TELEMETRY_TRUNCATED is set in VERSION.
+         */
+        class Telemetry : public Print
+        {
+          private:
+            uint8_t *_data = nullptr;
+            uint16_t _size = 0;
+            uint16_t _capacity = 0;
+            bool _truncated = false;
+
+            void truncate();
+            void record(const uint8_t type, const std::string &label, const uint8_t core);
+
+          public:
+            ~Telemetry();
+
+            size_t write(uint8_t byte) override;
+            size_t write(const uint8_t *buffer, size_t size) override;
+
+            /*
+             * Start a new snapshot
+             */
+            void begin(const int32_t freeMemoryMin, const int32_t freeStackMin, const int32_t freeStackMin1);
+            void add(const std::string &label, const uint8_t core, RuntimeStat &stat);
+            void add(const std::string &label, const uint8_t core, IsrStat &stat);
+
+            uint16_t size();
+            bool truncated();
+
+            /*
+             * Copy a part of the snapshot
+             * @return number of copied bytes
+             */
+            uint16_t read(const uint16_t offset, uint8_t *buffer, const uint16_t length);
+
+            /*
+             * Write the snapshot as hex lines to the console
+             */
+            void show();
+        };
+    } // namespace Stat
+} // namespace OpenKNX
@@ -1,7 +1,7 @@
 #include "OpenKNX/TimerInterrupt.h"
 #include "OpenKNX/Facade.h"
 
-#ifndef ARDUINO_ARCH_RP2040
+#if defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_ESP32)
     /*
      * Select a Interrupt for global TimerInterrupt
      * OPENKNX_TIMER_INTERRUPT
@@ -82,6 +82,10 @@ ESP32Timer ITimer(SELECTED_TIMER);
 
 #endif
 
+#ifdef OPENKNX_NATIVE
+    #include <chrono>
+#endif
+
 #ifdef ARDUINO_ARCH_RP2040
 bool __isr __time_critical_func(timerInterruptCallback)(repeating_timer *t)
 {
@@ -116,11 +120,22 @@ namespace OpenKNX
             openknx.timerInterrupt.interrupt();
             return true;
         });
+#elif defined(OPENKNX_NATIVE)
+        // the timer interrupt is emulated by a thread with real time interval (independent of Native::Clock)
+        _thread = std::thread([]() -> void {
+            while (true)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(OPENKNX_INTERRUPT_TIMER_MS));
+                openknx.timerInterrupt.interrupt();
+            }
+        });
+        _thread.detach();
 #endif
     }
 
     void __isr __time_critical_func(TimerInterrupt::interrupt)()
     {
+        ISR_MEASURE(runtime);
         _time = millis();
 
         processStats();
@@ -184,11 +199,21 @@ namespace OpenKNX
     #ifdef ARDUINO_ARCH_RP2040
         _alarmPool1 = alarm_pool_create(2, 16);
         alarm_pool_add_repeating_timer_ms(_alarmPool1, -OPENKNX_INTERRUPT_TIMER_MS, timerInterruptCallback1, NULL, &_repeatingTimer1);
+    #elif defined(OPENKNX_NATIVE)
+        _thread1 = std::thread([]() -> void {
+            while (true)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(OPENKNX_INTERRUPT_TIMER_MS));
+                openknx.timerInterrupt.interrupt1();
+            }
+        });
+        _thread1.detach();
     #endif
     }
 
     void __isr __time_critical_func(TimerInterrupt::interrupt1)()
     {
+        ISR_MEASURE(runtime1);
         _time1 = millis();
         processStats();
         processLeds();
@@ -1,6 +1,10 @@
 #pragma once
+#include "OpenKNX/Stat/IsrStat.h"
 #include "OpenKNX/defines.h"
 #include <Arduino.h>
+#ifdef OPENKNX_NATIVE
+    #include <thread>
+#endif
 
 // Interval of interrupt for leds and free memory collector
 #define OPENKNX_INTERRUPT_TIMER_MS 3
@@ -23,12 +27,25 @@ namespace OpenKNX
         struct repeating_timer _repeatingTimer1;
         alarm_pool_t *_alarmPool1;
     #endif
+#endif
+#ifdef OPENKNX_NATIVE
+        std::thread _thread;
+    #ifdef OPENKNX_DUALCORE
+        std::thread _thread1;
+    #endif
 #endif
         inline void processStats();
         inline void processButtons();
         inline void processLeds();
 
       public:
+#ifdef OPENKNX_RUNTIME_STAT
+        Stat::IsrStat runtime;
+    #ifdef OPENKNX_DUALCORE
+        Stat::IsrStat runtime1;
+    #endif
+#endif
+
         void init();
         void interrupt();
 #ifdef ARDUINO_ARCH_RP2040
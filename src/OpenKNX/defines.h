@@ -13,6 +13,25 @@
     #define OPENKNX_MAX_LOOPTIME 4000
 #endif
 
+// Guaranteed maximum time between two knx.loop() calls, even while modules are processed
+#ifndef OPENKNX_KNX_LOOP_INTERVAL // US
+    #define OPENKNX_KNX_LOOP_INTERVAL OPENKNX_MAX_LOOPTIME
+#endif
+
+// A module that was not called for this time will be called even if its predicted runtime exceeds the free loop time
+#ifndef OPENKNX_LOOP_STARVATION_TIME // MS
+    #define OPENKNX_LOOP_STARVATION_TIME 100
+#endif
+
+// Number of GroupObject ranges modules can subscribe by Module::subscribeInputKo
+#ifndef OPENKNX_MAX_KO_SUBSCRIPTIONS
+    #define OPENKNX_MAX_KO_SUBSCRIPTIONS 32
+#endif
+
+#define OPENKNX_LOOP_PRIORITY_LOW 64
+#define OPENKNX_LOOP_PRIORITY_NORMAL 128
+#define OPENKNX_LOOP_PRIORITY_HIGH 192
+
 #ifndef OPENKNX_LOOPTIME_WARNING // MS
     #define OPENKNX_LOOPTIME_WARNING 7
 #endif
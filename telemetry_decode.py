@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+#
+# Decoder for the runtime statistics snapshot of OGM-Common (OPENKNX_RUNTIME_STAT).
+#
+# The snapshot is taken by the console command "runtime export" (hex lines in the console output), the
+# diagnose KO ("tlm <n>") or the KNX function property OPENKNX_TELEMETRY_OBJECT/OPENKNX_TELEMETRY_PROPERTY.
+# The percentiles are calculated here from the histograms, so snapshots of several devices can be
+# compared in one table.
+#
+# Usage:
+#   python telemetry_decode.py capture.txt                       (console output with "runtime export")
+#   python telemetry_decode.py device1.bin device2.bin -o fleet.csv
+#   python telemetry_decode.py *.txt --plot fleet.png            (requires matplotlib)
+#
+import argparse
+import csv
+import re
+import struct
+import sys
+
+HEX_LINE = re.compile(r'Telemetry:\s+([0-9A-F]+)\s*$')
+BEGIN_LINE = re.compile(r'Telemetry:\s+begin (\d+)')
+END_LINE = re.compile(r'Telemetry:\s+end')
+RUNTIME = 1
+ISR = 2
+TRUNCATED = 0x80
+COLUMNS = ['device', 'type', 'label', 'core', 'count', 'sum_ms', 'min_us', 'avg_us', 'p50_us', 'p95_us', 'p99_us', 'max_us',
+           'wait_avg_us', 'wait_p95_us', 'minute_p95_us', 'minute_max_us', 'hour_p95_us', 'hour_max_us', 'load_percent']
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.position = 0
+
+    def unpack(self, format):
+        values = struct.unpack_from('<' + format, self.data, self.position)
+        self.position += struct.calcsize('<' + format)
+        return values if len(values) > 1 else values[0]
+
+    def take(self, size):
+        data = self.data[self.position:self.position + size]
+        self.position += size
+        return data
+
+    def done(self):
+        return self.position >= len(self.data)
+
+
+class Buckets:
+    def __init__(self, reader):
+        self.precision, self.count = reader.unpack('BB')
+        self.upper = None
+        if self.precision == 0xFF:
+            self.upper = [reader.unpack('I') for _ in range(self.count - 1)] + [0xFFFFFFFF]
+
+    def lower(self, index):
+        if self.upper is not None:
+            return 0 if index == 0 else self.upper[index - 1]
+        sub = 1 << self.precision
+        if index < sub:
+            return index
+        exponent = (index >> self.precision) + self.precision - 1
+        return ((index & (sub - 1)) + sub) << (exponent - self.precision)
+
+    def upper_limit(self, index):
+        if self.upper is not None:
+            return self.upper[index]
+        if index == self.count - 1:
+            return 0xFFFFFFFF
+        return self.lower(index + 1) - 1
+
+
+class Duration:
+    def __init__(self, reader):
+        self.count, self.sum_us, self.min_us, self.max_us = reader.unpack('QQII')
+        used = reader.unpack('B')
+        self.buckets = dict(reader.unpack('BI') for _ in range(used))
+
+    def avg(self):
+        return self.sum_us / self.count if self.count else 0
+
+    def percentile(self, percent, buckets):
+        # same estimation as DurationStatistic::estimatePercentile_us
+        if self.count == 0:
+            return 0
+        total = sum(self.buckets.values())
+        target = (total * percent + 99) // 100
+        cumulated = 0
+        for index in sorted(self.buckets):
+            if cumulated + self.buckets[index] >= target:
+                low = max(buckets.lower(index), self.min_us)
+                high = min(buckets.upper_limit(index), self.max_us)
+                return low + (high - low) * (target - cumulated) / self.buckets[index]
+            cumulated += self.buckets[index]
+        return self.max_us
+
+
+def record(reader, buckets, device):
+    type, core, length = reader.unpack('BBB')
+    label = reader.take(length).decode('utf-8', 'replace')
+    row = dict(device=device, label=label, core=core)
+    if type == RUNTIME:
+        run = Duration(reader)
+        wait = Duration(reader)
+        minute = reader.unpack('IIII')
+        hour = reader.unpack('IIII')
+        row.update(type='runtime', count=run.count, sum_ms=run.sum_us // 1000, min_us=run.min_us if run.count else 0,
+                   avg_us=round(run.avg(), 1), p50_us=round(run.percentile(50, buckets)), p95_us=round(run.percentile(95, buckets)),
+                   p99_us=round(run.percentile(99, buckets)), max_us=run.max_us, wait_avg_us=round(wait.avg(), 1),
+                   wait_p95_us=round(wait.percentile(95, buckets)), minute_p95_us=minute[2], minute_max_us=minute[3],
+                   hour_p95_us=hour[2], hour_max_us=hour[3])
+    elif type == ISR:
+        per_us, count, maximum, total, period = reader.unpack('HIIQI')
+        total_us = total / per_us
+        row.update(type='isr', count=count, sum_ms=round(total_us / 1000, 1), avg_us=round(total_us / count, 2) if count else 0,
+                   max_us=round(maximum / per_us, 1), load_percent=round(total_us / period / 10, 3) if period else 0)
+    else:
+        raise ValueError('unknown record type %d' % type)
+    return row
+
+
+def decode(data, device):
+    reader = Reader(data)
+    if reader.take(3) != b'OKT':
+        raise ValueError('no telemetry snapshot')
+    version, uptime, memory, stack, stack1 = reader.unpack('BIiii')
+    truncated = bool(version & TRUNCATED)
+    version &= ~TRUNCATED
+    if version != 1:
+        raise ValueError('unsupported version %d' % version)
+    buckets = Buckets(reader)
+
+    label = 'uptime_ms=%d free_memory_min=%d free_stack_min=%d free_stack_min1=%d' % (uptime, memory, stack, stack1)
+    rows = [dict(device=device, type='device', label=label + (' truncated' if truncated else ''))]
+    if truncated:
+        print('%s: snapshot truncated on the device, the last records are missing' % device, file=sys.stderr)
+    while not reader.done():
+        try:
+            rows.append(record(reader, buckets, device))
+        except struct.error:
+            # the last record of a truncated snapshot is incomplete
+            if truncated:
+                break
+            raise
+    return rows
+
+
+def snapshots(path):
+    with open(path, 'rb') as file:
+        content = file.read()
+    if content.startswith(b'OKT'):
+        yield content
+        return
+
+    # console output: hex lines between "begin" and "end"
+    data = None
+    for line in content.decode('utf-8', 'replace').splitlines():
+        if BEGIN_LINE.search(line):
+            data = bytearray()
+        elif data is not None and END_LINE.search(line):
+            yield bytes(data)
+            data = None
+        elif data is not None:
+            match = HEX_LINE.search(line)
+            if match:
+                data += bytes.fromhex(match.group(1))
+
+
+def plot(rows, path):
+    import matplotlib.pyplot as plt
+
+    rows = [row for row in rows if row['type'] == 'runtime' and row['count']]
+    labels = ['%s %s/%d' % (row['device'], row['label'], row['core']) for row in rows]
+    figure, axis = plt.subplots(figsize=(10, 0.3 * len(rows) + 1.5))
+    positions = range(len(rows))
+    axis.barh(positions, [row['max_us'] for row in rows], color='#f4cccc', label='max')
+    axis.barh(positions, [row['p99_us'] for row in rows], color='#ea9999', label='p99')
+    axis.barh(positions, [row['p95_us'] for row in rows], color='#e06666', label='p95')
+    axis.barh(positions, [row['p50_us'] for row in rows], color='#990000', label='p50')
+    axis.set_yticks(list(positions))
+    axis.set_yticklabels(labels, fontsize=8)
+    axis.set_xscale('log')
+    axis.set_xlabel('runtime [µs]')
+    axis.invert_yaxis()
+    axis.legend()
+    figure.tight_layout()
+    figure.savefig(path)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode runtime statistics snapshots of OGM-Common')
+    parser.add_argument('input', nargs='+', help='binary snapshot or console output with "runtime export" (one file per device)')
+    parser.add_argument('-o', '--output', help='csv file (default: stdout)')
+    parser.add_argument('--plot', help='save a chart of the module runtimes (e.g. runtime.png)')
+    args = parser.parse_args()
+
+    rows = []
+    for path in args.input:
+        for number, data in enumerate(snapshots(path)):
+            device = path if number == 0 else '%s#%d' % (path, number)
+            try:
+                rows += decode(data, device)
+            except (ValueError, struct.error) as error:
+                print('%s: invalid snapshot: %s' % (device, error), file=sys.stderr)
+
+    output = open(args.output, 'w', newline='') if args.output else sys.stdout
+    writer = csv.DictWriter(output, COLUMNS)
+    writer.writeheader()
+    writer.writerows(rows)
+
+    if args.plot:
+        plot(rows, args.plot)
+
+
+if __name__ == '__main__':
+    main()
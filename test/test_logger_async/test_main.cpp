@@ -0,0 +1,120 @@
+/*
+ * Unit tests of the asynchronous logging buffer (OPENKNX_LOGGER_ASYNC, native build).
+ *
+ * Run from the benchmark project (usual OpenKNX project layout):
+ *   cd lib/OGM-Common/benchmark
+ *   pio test -e test
+ */
+#include "OpenKNX.h"
+#include <string>
+#include <unity.h>
+
+// the knx stack provides no global instance on Linux
+KnxFacade<LinuxPlatform, Bau57B0> knx;
+
+class Capture : public Print
+{
+  public:
+    std::string text;
+
+    size_t write(uint8_t byte) override
+    {
+        text += (char)byte;
+        return 1;
+    }
+};
+
+static void writeLine(OpenKNX::Log::AsyncBuffer &buffer, const char *text)
+{
+    buffer.open();
+    buffer.print(text);
+    buffer.commit();
+}
+
+static int formatLine(OpenKNX::Log::AsyncBuffer &buffer, const char *message, ...)
+{
+    va_list values;
+    va_start(values, message);
+    const int length = buffer.format(message, values);
+    va_end(values);
+    return length;
+}
+
+void test_line()
+{
+    OpenKNX::Log::AsyncBuffer buffer;
+    Capture capture;
+    writeLine(buffer, "first");
+    writeLine(buffer, "second");
+    TEST_ASSERT_FALSE(buffer.lineOpen());
+    TEST_ASSERT_TRUE(buffer.drain(capture, OPENKNX_LOGGER_ASYNC_BUFFER));
+    TEST_ASSERT_EQUAL_STRING("firstsecond", capture.text.c_str());
+    TEST_ASSERT_EQUAL_UINT32(0, buffer.dropped());
+}
+
+void test_nested_line()
+{
+    OpenKNX::Log::AsyncBuffer buffer;
+    Capture capture;
+
+    // e.g. a log line from an interrupt while the outer line is in progress
+    buffer.open();
+    buffer.print("outer ");
+    writeLine(buffer, "nested");
+    TEST_ASSERT_TRUE(buffer.lineOpen());
+    buffer.print("line");
+    buffer.commit();
+    TEST_ASSERT_FALSE(buffer.lineOpen());
+
+    // the buffer still works after the nested line
+    writeLine(buffer, " next");
+    buffer.drain(capture, OPENKNX_LOGGER_ASYNC_BUFFER);
+    TEST_ASSERT_EQUAL_STRING_LEN("outer line next", capture.text.c_str(), 15);
+    TEST_ASSERT_EQUAL_UINT32(1, buffer.dropped());
+    TEST_ASSERT_TRUE(capture.text.find("1 log lines dropped") != std::string::npos);
+}
+
+void test_format()
+{
+    OpenKNX::Log::AsyncBuffer buffer;
+    Capture capture;
+    buffer.open();
+    buffer.print("value ");
+    TEST_ASSERT_EQUAL_UINT32(6, formatLine(buffer, "%i %s", 42, "abc"));
+
+    // not formatted in a nested line
+    buffer.open();
+    TEST_ASSERT_EQUAL_UINT32(0, formatLine(buffer, "%i", 43));
+    buffer.commit();
+
+    buffer.print("!");
+    buffer.commit();
+    buffer.drain(capture, OPENKNX_LOGGER_ASYNC_BUFFER);
+    TEST_ASSERT_EQUAL_STRING_LEN("value 42 abc!", capture.text.c_str(), 13);
+}
+
+void test_full()
+{
+    OpenKNX::Log::AsyncBuffer buffer;
+    Capture capture;
+    char line[101] = {};
+    memset(line, 'x', 100);
+
+    const uint16_t lines = OPENKNX_LOGGER_ASYNC_BUFFER / (100 + 2);
+    for (uint16_t i = 0; i < lines + 1; i++)
+        writeLine(buffer, line);
+
+    TEST_ASSERT_EQUAL_UINT32(1, buffer.dropped());
+    buffer.drain(capture, OPENKNX_LOGGER_ASYNC_BUFFER);
+    TEST_ASSERT_EQUAL_UINT32(lines * 100, capture.text.find("\33[2K"));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_line);
+    RUN_TEST(test_nested_line);
+    RUN_TEST(test_format);
+    RUN_TEST(test_full);
+    return UNITY_END();
+}